@@ -45,21 +45,55 @@ namespace boost {
 #ifndef BOOST_FUNCTION_NO_FUNCTION_TYPE_SYNTAX
   namespace BOOST_SIGNALS_NAMESPACE {
     namespace detail {
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+      template<typename Signature,
+               typename Combiner,
+               typename Group,
+               typename GroupCompare,
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
+      struct get_signal_impl
+      {
+        typedef variadic_signal<Signature,
+                                Combiner,
+                                Group,
+                                GroupCompare,
+                                SlotFunction,
+                                SlotStorage,
+                                LockPolicy,
+                                Allocator> type;
+      };
+
+      template<typename Signature>
+      struct default_combiner
+      {
+        typedef last_value<typename signature_result<Signature>::type> type;
+      };
+#else
       template<int Arity,
                typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl;
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<0, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -68,16 +102,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<1, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -87,16 +128,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<2, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -107,16 +155,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<3, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -128,16 +183,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<4, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -150,16 +212,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<5, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -173,16 +242,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<6, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -197,16 +273,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<7, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -222,16 +305,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<8, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -248,16 +338,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<9, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -275,16 +372,23 @@ namespace boost {
                         Combiner,
                         Group,
                         GroupCompare,
-                        SlotFunction> type;
+                        SlotFunction,
+                        SlotStorage,
+                        LockPolicy,
+                        Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       class real_get_signal_impl<10, Signature, Combiner, Group, GroupCompare,
-                                 SlotFunction>
+                                 SlotFunction, SlotStorage, LockPolicy,
+                                 Allocator>
       {
         typedef function_traits<Signature> traits;
 
@@ -303,24 +407,41 @@ namespace boost {
                          Combiner,
                          Group,
                          GroupCompare,
-                         SlotFunction> type;
+                         SlotFunction,
+                         SlotStorage,
+                         LockPolicy,
+                         Allocator> type;
       };
 
       template<typename Signature,
                typename Combiner,
                typename Group,
                typename GroupCompare,
-               typename SlotFunction>
+               typename SlotFunction,
+               typename SlotStorage,
+               typename LockPolicy,
+               typename Allocator>
       struct get_signal_impl :
         public real_get_signal_impl<(function_traits<Signature>::arity),
                                     Signature,
                                     Combiner,
                                     Group,
                                     GroupCompare,
-                                    SlotFunction>
+                                    SlotFunction,
+                                    SlotStorage,
+                                    LockPolicy,
+                                    Allocator>
       {
       };
 
+
+      template<typename Signature>
+      struct default_combiner
+      {
+        typedef last_value<typename function_traits<Signature>::result_type>
+          type;
+      };
+#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
     } // end namespace detail
   } // end namespace BOOST_SIGNALS_NAMESPACE
 
@@ -329,24 +450,35 @@ namespace boost {
   // class name.
   template<
     typename Signature, // function type R (T1, T2, ..., TN)
-    typename Combiner = last_value<typename function_traits<Signature>::result_type>,
+    typename Combiner =
+      typename BOOST_SIGNALS_NAMESPACE::detail::default_combiner<
+                 Signature>::type,
     typename Group = int,
     typename GroupCompare = std::less<Group>,
-    typename SlotFunction = function<Signature>
+    typename SlotFunction = function<Signature>,
+    typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+    typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,
+    typename Allocator = std::allocator<void>
   >
   class signal :
     public BOOST_SIGNALS_NAMESPACE::detail::get_signal_impl<Signature,
                                                             Combiner,
                                                             Group,
                                                             GroupCompare,
-                                                            SlotFunction>::type
+                                                            SlotFunction,
+                                                            SlotStorage,
+                                                            LockPolicy,
+                                                            Allocator>::type
   {
     typedef typename BOOST_SIGNALS_NAMESPACE::detail::get_signal_impl<
                        Signature,
                        Combiner,
                        Group,
                        GroupCompare,
-                       SlotFunction>::type base_type;
+                       SlotFunction,
+                       SlotStorage,
+                       LockPolicy,
+                       Allocator>::type base_type;
 
   public:
     explicit signal(const Combiner& combiner = Combiner(),
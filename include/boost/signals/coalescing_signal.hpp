@@ -0,0 +1,212 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_COALESCING_SIGNAL_HEADER
+#define BOOST_SIGNALS_COALESCING_SIGNAL_HEADER
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+    || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#  error "boost/signals/coalescing_signal.hpp requires variadic templates"
+#endif
+
+#include <boost/signal.hpp>
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/queued_signal.hpp>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    // The key of a coalescing signal whose calls all replace each other
+    struct single_key {
+      friend bool operator<(single_key, single_key) { return false; }
+    };
+
+    namespace detail {
+      // The default key of a coalescing signal: its first argument, if
+      // it has one
+      template<typename Signature> struct first_argument_key;
+
+      template<typename R>
+      struct first_argument_key<R ()> {
+        typedef single_key type;
+      };
+
+      template<typename R, typename T1, typename... Args>
+      struct first_argument_key<R (T1, Args...)> {
+        typedef typename queued_argument<T1>::type type;
+      };
+
+      // Makes the key of a call from its arguments
+      template<typename Key>
+      struct key_from_arguments {
+        template<typename T1, typename... Args>
+        static Key get(const T1& a1, const Args&...) { return Key(a1); }
+      };
+
+      template<>
+      struct key_from_arguments<single_key> {
+        template<typename... Args>
+        static single_key get(const Args&...) { return single_key(); }
+      };
+    } // end namespace detail
+
+    // A signal whose calls may be recorded and delivered together later.
+    // Each recorded call has a key, and replaces the arguments of the
+    // call recorded with the same key since the last flush, so that
+    // flush() calls the slots once per key, with the latest arguments.
+    // The keys are compared with operator<, and by default are the
+    // first argument.
+    //
+    // Calls may be recorded from several threads at once if LockPolicy
+    // is a lock, but only one thread at a time may flush the signal, and
+    // its slots must not flush it.
+    template<
+      typename Signature,
+      typename Key = typename detail::first_argument_key<Signature>::type,
+      typename Combiner =
+        typename detail::default_combiner<Signature>::type,
+      typename Group = int,
+      typename GroupCompare = std::less<Group>,
+      typename SlotFunction = function<Signature>,
+      typename SlotStorage = flat_slot_storage,
+      typename LockPolicy = null_lock,
+      typename Allocator = std::allocator<void>
+    >
+    class coalescing_signal;
+
+    template<typename R, typename... Args, typename Key, typename Combiner,
+             typename Group, typename GroupCompare, typename SlotFunction,
+             typename SlotStorage, typename LockPolicy, typename Allocator>
+    class coalescing_signal<R (Args...), Key, Combiner, Group, GroupCompare,
+                            SlotFunction, SlotStorage, LockPolicy,
+                            Allocator> :
+      public boost::signal<R (Args...), Combiner, Group, GroupCompare,
+                           SlotFunction, SlotStorage, LockPolicy, Allocator>
+    {
+      typedef boost::signal<R (Args...), Combiner, Group, GroupCompare,
+                            SlotFunction, SlotStorage, LockPolicy, Allocator>
+        base_type;
+      typedef std::tuple<typename detail::queued_argument<Args>::type...>
+        arguments_type;
+      typedef std::vector<arguments_type> call_list;
+
+    public:
+      typedef Key key_type;
+
+      explicit coalescing_signal(const Combiner& combiner = Combiner(),
+                                 const GroupCompare& group_compare =
+                                   GroupCompare()) :
+        base_type(combiner, group_compare), recorded(0)
+      {
+      }
+
+      // Records a call under the key made from its first argument, or
+      // under the single key
+      void post(const typename detail::queued_argument<Args>::type&... args)
+      {
+        post_with_key(detail::key_from_arguments<Key>::get(args...),
+                      args...);
+      }
+
+      // Records a call under the given key
+      void post_with_key(const Key& key,
+                         const typename detail::queued_argument<Args>::type&...
+                           args)
+      {
+        lock_guard lock(pending_lock);
+        typename std::map<Key, std::size_t>::iterator pos =
+          positions.lower_bound(key);
+        if (pos != positions.end() && !(key < pos->first)) {
+          calls[pos->second] = std::forward_as_tuple(args...);
+          return;
+        }
+
+        // The storage of calls delivered earlier is reused
+        if (recorded < calls.size())
+          calls[recorded] = std::forward_as_tuple(args...);
+        else
+          calls.push_back(arguments_type(args...));
+        positions.insert(pos, std::make_pair(key, recorded));
+        ++recorded;
+      }
+
+      // Calls the signal once for each key recorded since the last flush,
+      // with the latest arguments, in the order in which the keys were
+      // first recorded, and returns the number of calls. Calls recorded
+      // meanwhile, by the slots or by other threads, are left for the
+      // next flush. If a slot throws, the exception is passed on and the
+      // calls not yet delivered are dropped.
+      std::size_t flush()
+      {
+        std::size_t n;
+        {
+          lock_guard lock(pending_lock);
+          calls.swap(delivered);
+          n = recorded;
+          recorded = 0;
+          positions.clear();
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+          invoke(delivered[i],
+                 typename detail::make_index_list<sizeof...(Args)>::type());
+        return n;
+      }
+
+      // The number of keys recorded since the last flush
+      std::size_t num_pending() const
+      {
+        lock_guard lock(pending_lock);
+        return recorded;
+      }
+
+    private:
+      struct lock_guard {
+        explicit lock_guard(LockPolicy& l) : lock(l) { lock.lock(); }
+        ~lock_guard() { lock.unlock(); }
+        LockPolicy& lock;
+      };
+
+      template<std::size_t... I>
+      void invoke(arguments_type& args, detail::index_list<I...>)
+      {
+        (*this)(static_cast<
+                  typename detail::forwarded_argument<Args>::type>(
+                    std::get<I>(args))...);
+      }
+
+      // The calls recorded since the last flush, in the order in which
+      // their keys were first recorded, followed by storage to reuse
+      call_list calls;
+      std::size_t recorded;
+      std::map<Key, std::size_t> positions;
+
+      // The calls being delivered by flush
+      call_list delivered;
+
+      mutable LockPolicy pending_lock;
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_COALESCING_SIGNAL_HEADER
@@ -0,0 +1,257 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_COMBINERS_HEADER
+#define BOOST_SIGNALS_COMBINERS_HEADER
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/detail/reduction.hpp>
+#include <cstddef>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+// Combiners for common ways of looking at the results of the slots. The
+// slots are only called when their results are needed, so the combiners
+// that can tell the outcome before the end stop calling slots there.
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    // The first result that converts to true, such as a non-null
+    // pointer, or T() if there is none. Stops at that result.
+    template<typename T>
+    struct first_non_null {
+      typedef T result_type;
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        for (; first != last; ++first) {
+          T value = *first;
+          if (value)
+            return value;
+        }
+        return T();
+      }
+    };
+
+    // Whether any result is true; stops at the first true result
+    struct any_true {
+      typedef bool result_type;
+
+      template<typename InputIterator>
+      bool operator()(InputIterator first, InputIterator last) const
+      {
+        for (; first != last; ++first) {
+          if (*first)
+            return true;
+        }
+        return false;
+      }
+    };
+
+    // Whether all results are true; stops at the first false result
+    struct all_true {
+      typedef bool result_type;
+
+      template<typename InputIterator>
+      bool operator()(InputIterator first, InputIterator last) const
+      {
+        for (; first != last; ++first) {
+          if (!*first)
+            return false;
+        }
+        return true;
+      }
+    };
+
+    // The results of the first n slots, in order. The slots after
+    // those are not called.
+    template<typename T, typename Container = std::vector<T> >
+    struct first_n {
+      typedef Container result_type;
+
+      explicit first_n(std::size_t n = 1) : count(n) {}
+
+      template<typename InputIterator>
+      Container operator()(InputIterator first, InputIterator last) const
+      {
+        Container results;
+        for (std::size_t i = 0; i < count && first != last; ++i, ++first)
+          results.push_back(*first);
+        return results;
+      }
+
+      std::size_t count;
+    };
+
+    // The smallest result, or T() if there are no slots
+    template<typename T>
+    struct minimum {
+      typedef T result_type;
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        if (first == last)
+          return T();
+
+        T smallest = *first;
+        for (++first; first != last; ++first) {
+          T value = *first;
+          if (value < smallest)
+            smallest = value;
+        }
+        return smallest;
+      }
+    };
+
+    // The largest result, or T() if there are no slots
+    template<typename T>
+    struct maximum {
+      typedef T result_type;
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        if (first == last)
+          return T();
+
+        T largest = *first;
+        for (++first; first != last; ++first) {
+          T value = *first;
+          if (largest < value)
+            largest = value;
+        }
+        return largest;
+      }
+    };
+
+    // The sum of the results, starting from T()
+    template<typename T>
+    struct sum {
+      typedef T result_type;
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        T total = T();
+        for (; first != last; ++first)
+          total += *first;
+        return total;
+      }
+    };
+
+    // Stores the results in the given container, replacing its contents,
+    // and returns it. Clearing a vector keeps its capacity, so a vector
+    // that has room for the results is not reallocated.
+    template<typename Container>
+    struct collect_into {
+      typedef Container& result_type;
+
+      explicit collect_into(Container& c) : results(&c) {}
+
+      template<typename InputIterator>
+      Container& operator()(InputIterator first, InputIterator last) const
+      {
+        results->clear();
+        for (; first != last; ++first)
+          results->push_back(*first);
+        return *results;
+      }
+
+      Container* results;
+    };
+
+    // The following combiners store the results in a buffer, reserved
+    // for the given number of results, and reduce the whole buffer at
+    // once. The buffer is kept from one call to the next; a call made
+    // while another is using it, from a slot or from another thread,
+    // allocates a buffer of its own.
+
+    // The sum of the results, starting from T(). The results are not
+    // added in order, so a floating-point sum may differ slightly from
+    // that of sum.
+    template<typename T>
+    struct buffered_sum : detail::result_buffer<T> {
+      typedef T result_type;
+
+      explicit buffered_sum(std::size_t capacity = 0) :
+        detail::result_buffer<T>(capacity)
+      {
+      }
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        return this->reduce(first, last, &detail::reduce_sum<T>, T());
+      }
+    };
+
+    // The smallest result, or T() if there are no slots
+    template<typename T>
+    struct buffered_minimum : detail::result_buffer<T> {
+      typedef T result_type;
+
+      explicit buffered_minimum(std::size_t capacity = 0) :
+        detail::result_buffer<T>(capacity)
+      {
+      }
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        return this->reduce(first, last, &detail::reduce_min<T>, T());
+      }
+    };
+
+    // The largest result, or T() if there are no slots
+    template<typename T>
+    struct buffered_maximum : detail::result_buffer<T> {
+      typedef T result_type;
+
+      explicit buffered_maximum(std::size_t capacity = 0) :
+        detail::result_buffer<T>(capacity)
+      {
+      }
+
+      template<typename InputIterator>
+      T operator()(InputIterator first, InputIterator last) const
+      {
+        return this->reduce(first, last, &detail::reduce_max<T>, T());
+      }
+    };
+
+    // The position, among the slots called, of the first slot that
+    // returned the largest result, or 0 if there are no slots
+    template<typename T>
+    struct buffered_argmax : detail::result_buffer<T> {
+      typedef std::size_t result_type;
+
+      explicit buffered_argmax(std::size_t capacity = 0) :
+        detail::result_buffer<T>(capacity)
+      {
+      }
+
+      template<typename InputIterator>
+      std::size_t operator()(InputIterator first, InputIterator last) const
+      {
+        return this->reduce(first, last, &detail::reduce_argmax<T>,
+                            std::size_t(0));
+      }
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_COMBINERS_HEADER
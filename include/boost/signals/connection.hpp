@@ -14,8 +14,14 @@
 #include <boost/smart_ptr.hpp>
 #include <boost/operators.hpp>
 #include <boost/any.hpp>
-#include <list>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/detail/atomic_count.hpp>
+#include <boost/atomic.hpp>
+#include <vector>
 #include <cassert>
+#include <cstddef>
+#include <new>
 #include <utility>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -27,13 +33,36 @@ namespace boost {
     class trackable;
 
     namespace detail {
+      struct basic_connection;
+
+      // Links a connection into the list of connections of a trackable
+      // object. The list is circular and doubly linked, and its head is
+      // kept in the trackable object, so that linking and unlinking a
+      // connection takes constant time and allocates nothing.
+      struct trackable_hook {
+        trackable_hook() : prev(0), next(0), con(0) {}
+
+        bool linked() const { return next != 0; }
+
+        trackable_hook* prev;
+        trackable_hook* next;
+
+        // The connection that owns the hook, or 0 for the list head
+        basic_connection* con;
+      };
+
       // Represents an object that has been bound as part of a slot, and how
       // to notify that object of a disconnect
       struct bound_object {
+        bound_object() : obj(0), data(0), disconnect(0) {}
+
         void* obj;
         void* data;
         void (*disconnect)(void*, void*);
 
+        // Where a trackable object links the connection into its list
+        trackable_hook hook;
+
         bool operator==(const bound_object& other) const
           { return obj == other.obj && data == other.data; }
         bool operator<(const bound_object& other) const
@@ -46,16 +75,129 @@ namespace boost {
         { return !(*this < other); }
       };
 
+      // The objects bound to a slot. Most slots bind at most one trackable
+      // object, so the first few are stored inline and only the rest are
+      // allocated. Trackable objects link the hooks of the bound objects
+      // into their lists, so the bound objects must not move once they
+      // are linked: the list is reserved before they are added.
+      class bound_object_list {
+      public:
+        bound_object_list() : inline_size(0) {}
+
+        std::size_t size() const { return inline_size + overflow.size(); }
+
+        bound_object& operator[](std::size_t i)
+        {
+          return i < inline_capacity? inline_objects[i]
+                                    : overflow[i - inline_capacity];
+        }
+
+        const bound_object& operator[](std::size_t i) const
+        {
+          return i < inline_capacity? inline_objects[i]
+                                    : overflow[i - inline_capacity];
+        }
+
+        void reserve(std::size_t n)
+        {
+          if (n > inline_capacity)
+            overflow.reserve(n - inline_capacity);
+        }
+
+        void push_back(const bound_object& b)
+        {
+          if (inline_size < inline_capacity)
+            inline_objects[inline_size++] = b;
+          else
+            overflow.push_back(b);
+        }
+
+      private:
+        enum { inline_capacity = 2 };
+
+        bound_object inline_objects[inline_capacity];
+        std::size_t inline_size;
+        std::vector<bound_object> overflow;
+      };
+
       // Describes the connection between a signal and the objects that are
       // bound for a specific slot. Enables notification of the signal and the
       // slots when a disconnect is requested.
+      // Connections share it through an intrusive reference count, and it
+      // keeps the bound objects and the position of the slot inside itself,
+      // so that connecting a slot allocates only the basic_connection.
       struct basic_connection {
+        // Bits of the connection state
+        enum { connected_bit = 1, blocked_bit = 2 };
+
+        basic_connection() :
+          signal(0), signal_data(0), signal_disconnect(0), state(0),
+          ref_count(0), destroy(&destroy_new)
+        {
+        }
+
+        // Notifies the signal of a disconnect. It is passed the signal and
+        // this basic_connection, and finds the slot through signal_data,
+        // which the signal may update while the slot is connected.
         void* signal;
         void* signal_data;
         void (*signal_disconnect)(void*, void*);
-        bool blocked_;
 
-        std::list<bound_object> bound_objects;
+        // Whether the connection is connected and whether it is blocked,
+        // in a single word, so that they can be tested and changed from
+        // any thread while the signal is being called. Only the thread
+        // that clears connected_bit notifies the signal and the bound
+        // objects.
+        boost::atomic<unsigned int> state;
+
+        bound_object_list bound_objects;
+
+        // Space in which the slot container may keep the position of the
+        // slot, instead of allocating it (see slot_map_base::insert_slot)
+        typedef aligned_storage<4 * sizeof(void*)> slot_position_type;
+        slot_position_type slot_position;
+
+        boost::detail::atomic_count ref_count;
+
+        // Destroys and frees the basic_connection once it is no longer
+        // referenced, in the way that suits how it was allocated
+        void (*destroy)(basic_connection*);
+
+        static void destroy_new(basic_connection* con) { delete con; }
+      };
+
+      inline void intrusive_ptr_add_ref(basic_connection* con)
+      {
+        ++con->ref_count;
+      }
+
+      inline void intrusive_ptr_release(basic_connection* con)
+      {
+        if (--con->ref_count == 0)
+          con->destroy(con);
+      }
+
+      // Allocates basic_connection objects with the allocator of a signal
+      template<typename Allocator>
+      struct basic_connection_allocator {
+        typedef typename rebind_allocator<Allocator, basic_connection>::type
+          allocator_type;
+
+        static basic_connection* create()
+        {
+          allocator_type allocator;
+          basic_connection* con = allocator.allocate(1);
+          new (static_cast<void*>(con)) basic_connection();
+          con->destroy = &destroy;
+          return con;
+        }
+
+        static void destroy(basic_connection* con)
+        {
+          allocator_type allocator;
+          con->~basic_connection();
+          allocator.deallocate(con, 1);
+        }
       };
     } // end namespace detail
 
@@ -72,15 +214,34 @@ namespace boost {
 
       // Block he connection: if the connection is still active, there
       // will be no notification
-      void block(bool should_block = true) { con->blocked_ = should_block; }
-      void unblock() { con->blocked_ = false; }
-      bool blocked() const { return !connected() || con->blocked_; }
+      void block(bool should_block = true)
+      {
+        if (should_block)
+          con->state.fetch_or(detail::basic_connection::blocked_bit);
+        else
+          unblock();
+      }
+
+      void unblock()
+      { con->state.fetch_and(~detail::basic_connection::blocked_bit); }
+
+      bool blocked() const
+      {
+        return !con.get() ||
+          con->state.load(memory_order_acquire)
+            != detail::basic_connection::connected_bit;
+      }
 
       // Disconnect the signal and slot, if they are connected
       void disconnect() const;
 
       // Returns true if the signal and slot are connected
-      bool connected() const { return con.get() && con->signal_disconnect; }
+      bool connected() const
+      {
+        return con.get() &&
+          (con->state.load(memory_order_acquire)
+             & detail::basic_connection::connected_bit);
+      }
 
       // Comparison of connections
       bool operator==(const connection& other) const;
@@ -97,7 +258,7 @@ namespace boost {
       void set_controlling(bool control = true)
       { controlling_connection = control; }
 
-      shared_ptr<BOOST_SIGNALS_NAMESPACE::detail::basic_connection>
+      intrusive_ptr<BOOST_SIGNALS_NAMESPACE::detail::basic_connection>
       get_connection() const
       { return con; }
 
@@ -115,7 +276,7 @@ namespace boost {
       friend class BOOST_SIGNALS_NAMESPACE::detail::bound_objects_visitor;
 
       // Pointer to the actual contents of the connection
-      shared_ptr<BOOST_SIGNALS_NAMESPACE::detail::basic_connection> con;
+      intrusive_ptr<BOOST_SIGNALS_NAMESPACE::detail::basic_connection> con;
 
       // True if the destruction of this connection object should disconnect
       bool controlling_connection;
@@ -158,49 +319,35 @@ namespace boost {
         bool operator<(const connection_slot_pair&) const { return false;}
       };
 
+      // The slot function stored along with a connection
+      template<typename SlotFunction>
+      inline SlotFunction& stored_function(const connection_slot_pair& slot)
+      {
+        return *const_cast<SlotFunction*>(
+                  unsafe_any_cast<SlotFunction>(&slot.second));
+      }
+
       // Determines if the underlying connection is disconnected
       struct is_disconnected {
-        typedef connection_slot_pair argument_type;
         typedef bool result_type;
 
-        inline bool operator()(const argument_type& c) const
+        template<typename Slot>
+        inline bool operator()(const Slot& c) const
         {
           return !c.first.connected();
         }
       };
 
       // Determines if the underlying connection is callable, ie if
-      // it is connected and not blocked
+      // it is connected and not blocked (which blocked() tests at once)
       struct is_callable {
-        typedef connection_slot_pair argument_type;
         typedef bool result_type;
 
-        inline bool operator()(const argument_type& c) const
-        {
-          return c.first.connected() && !c.first.blocked() ;
-        }
-      };
-
-      // Autodisconnects the bound object when it is destroyed unless the
-      // release method is invoked.
-      class auto_disconnect_bound_object {
-      public:
-        auto_disconnect_bound_object(const bound_object& b) :
-          binding(b), auto_disconnect(true)
-        {
-        }
-
-        ~auto_disconnect_bound_object()
+        template<typename Slot>
+        inline bool operator()(const Slot& c) const
         {
-          if (auto_disconnect)
-            binding.disconnect(binding.obj, binding.data);
+          return !c.first.blocked();
         }
-
-        void release() { auto_disconnect = false; }
-
-      private:
-        bound_object binding;
-        bool auto_disconnect;
       };
     } // end namespace detail
   } // end namespace BOOST_SIGNALS_NAMESPACE
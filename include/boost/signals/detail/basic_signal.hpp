@@ -0,0 +1,298 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_BASIC_SIGNAL_HPP
+#define BOOST_SIGNALS_BASIC_SIGNAL_HPP
+
+#include <boost/config.hpp>
+#include <boost/signals/connection.hpp>
+#include <boost/signals/slot.hpp>
+#include <boost/signals/slot_storage.hpp>
+#include <boost/signals/trackable.hpp>
+#include <boost/last_value.hpp>
+#include <boost/signals/detail/signal_base.hpp>
+#include <boost/signals/detail/slot_call_iterator.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // The part of a signal class that does not depend on the arguments
+      // of the signal: connecting and disconnecting slots, and calling
+      // them through a caller that binds the arguments. The signalN class
+      // templates derive from it.
+      template<
+        typename R,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      class basic_signal :
+        public signal_base, // management of slot list
+        public trackable // signals are trackable
+      {
+      public:
+        // The slot function type
+        typedef SlotFunction slot_function_type;
+
+        // Result type of a slot
+        typedef typename slot_result_type<R>::type slot_result_type;
+
+      protected:
+        // The container holding the slots
+        typedef typename SlotStorage::template map_type<SlotFunction, Group,
+                                                        GroupCompare,
+                                                        Allocator>::type
+          slot_map_type;
+
+        // The lock the signal uses, if any
+        typedef typename SlotStorage::template lock_type<LockPolicy>::type
+          lock_type;
+
+        // Keeps the slots in place while they are being called, and the
+        // iterator through them
+        typedef slot_call_scope<slot_map_type,
+                                !is_same<lock_type, null_lock>::value>
+          call_scope;
+        typedef typename call_scope::iterator iterator;
+
+      public:
+        // Combiner's result type
+        typedef typename Combiner::result_type result_type;
+
+        // Combiner type
+        typedef Combiner combiner_type;
+
+        // Slot type
+        typedef slot<slot_function_type, Allocator> slot_type;
+
+        // Slot name type and comparison
+        typedef Group group_type;
+        typedef GroupCompare group_compare_type;
+
+        // Slot storage selector
+        typedef SlotStorage slot_storage_type;
+
+        // Lock policy
+        typedef LockPolicy lock_policy_type;
+
+        // Allocator for the slots and connections
+        typedef Allocator allocator_type;
+
+        explicit
+        basic_signal(const Combiner& c, const GroupCompare& comp) :
+          signal_base(&comp, c, &create_slot_map<slot_map_type>,
+                      &create_signal_lock<lock_type>)
+        {
+        }
+
+        // Connect a slot to this signal
+        connection connect(const slot_type&, connect_position at = at_back);
+
+        connection connect(const group_type&, const slot_type&,
+                           connect_position at = at_back);
+
+        // Connect each of the slots in [first, last), in a single
+        // operation, as if each were connected in turn. Returns their
+        // connections, in the same order.
+        template<typename InputIterator>
+        std::vector<connection>
+        connect_range(InputIterator first, InputIterator last,
+                      connect_position at = at_back)
+        {
+          std::vector<connection> connections;
+          slot_range<slot_type, InputIterator> slots(first, last);
+          impl->connect_slots(stored_group(), at, slots, connections);
+          return connections;
+        }
+
+        template<typename InputIterator>
+        std::vector<connection>
+        connect_range(const group_type& group,
+                      InputIterator first, InputIterator last,
+                      connect_position at = at_back)
+        {
+          std::vector<connection> connections;
+          slot_range<slot_type, InputIterator> slots(first, last);
+          impl->connect_slots(stored_group::borrow(group), at, slots,
+                              connections);
+          return connections;
+        }
+
+        template<typename T>
+        void disconnect(const T& t)
+        {
+          typedef mpl::bool_<(is_convertible<T, group_type>::value)>
+            is_group;
+          this->do_disconnect(t, is_group());
+        }
+
+        Combiner& combiner()
+        { return *unsafe_any_cast<Combiner>(&impl->combiner_); }
+
+        const Combiner& combiner() const
+        { return *unsafe_any_cast<const Combiner>(&impl->combiner_); }
+
+      protected:
+        // Call the slots through the given caller, which passes them the
+        // arguments of the signal, and combine their results
+        template<typename Caller>
+        result_type call_slots(const Caller& f)
+        {
+          typedef slot_call_iterator<Caller, iterator> call_iterator;
+
+          // Notify the slot handling code that we are making a call
+          call_scope slots(this->impl,
+                           this->template slot_map<slot_map_type>());
+
+          // Let the combiner call the slots via a pair of input iterators
+          return combiner()(call_iterator(slots.begin(), slots.end(), f),
+                            call_iterator(slots.end(), slots.end(), f));
+        }
+
+        template<typename Caller>
+        result_type call_slots(const Caller& f) const
+        {
+          typedef slot_call_iterator<Caller, iterator> call_iterator;
+
+          call_scope slots(this->impl,
+                           this->template slot_map<slot_map_type>());
+          return combiner()(call_iterator(slots.begin(), slots.end(), f),
+                            call_iterator(slots.end(), slots.end(), f));
+        }
+
+      private:
+        // Disconnect a named slot
+        void do_disconnect(const group_type& group, mpl::bool_<true>)
+        {
+          impl->disconnect(stored_group::borrow(group));
+        }
+
+        template<typename Function>
+        void do_disconnect(const Function& f, mpl::bool_<false>);
+      };
+
+      template<
+        typename R,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      connection
+      basic_signal<
+        R, Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+        LockPolicy, Allocator
+      >::connect(const slot_type& in_slot, connect_position at)
+      {
+        // If the slot has been disconnected, just return a disconnected
+        // connection
+        if (!in_slot.is_active()) {
+          return connection();
+        }
+
+        return impl->connect_slot(&in_slot.get_slot_function(),
+                                  stored_group(), in_slot.get_data(), at);
+      }
+
+      template<
+        typename R,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      connection
+      basic_signal<
+        R, Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+        LockPolicy, Allocator
+      >::connect(const group_type& group, const slot_type& in_slot,
+                 connect_position at)
+      {
+        // If the slot has been disconnected, just return a disconnected
+        // connection
+        if (!in_slot.is_active()) {
+          return connection();
+        }
+
+        // The slot container copies the group name if it needs to keep it
+        return impl->connect_slot(&in_slot.get_slot_function(),
+                                  stored_group::borrow(group),
+                                  in_slot.get_data(), at);
+      }
+
+      template<
+        typename R,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      template<typename Function>
+      void
+      basic_signal<
+        R, Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+        LockPolicy, Allocator
+      >::do_disconnect(const Function& f, mpl::bool_<false>)
+      {
+        // Gather the matching slots, then disconnect them once the slots
+        // are no longer being iterated through (and the lock of the
+        // signal, if any, has been released)
+        std::vector<connection> matches;
+        {
+          // Notify the slot handling code that we are iterating through
+          // the slots
+          call_scope slots(this->impl,
+                           this->template slot_map<slot_map_type>());
+          for (iterator i = slots.begin(); i != slots.end(); ++i) {
+            // Skip slots that are disconnected: their slot function may
+            // already be gone
+            if (!i->first.connected()) continue;
+
+            slot_function_type& s =
+              stored_function<slot_function_type>(*i);
+            if (s == f) {
+              matches.push_back(i->first);
+              matches.back().set_controlling(false);
+            }
+          }
+        }
+        signal_base_impl::disconnect_each(matches);
+      }
+    } // end namespace detail
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_BASIC_SIGNAL_HPP
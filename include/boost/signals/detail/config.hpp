@@ -31,6 +31,17 @@
 #  define BOOST_SIGNALS_DECL
 #endif
 
+// Signals are implemented with variadic templates where the compiler
+// supports them, unless BOOST_SIGNALS_NO_VARIADIC_TEMPLATES is defined;
+// otherwise each signalN class is generated by the preprocessor
+#if !defined(BOOST_SIGNALS_NO_VARIADIC_TEMPLATES) \
+    && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+    && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) \
+    && !defined(BOOST_NO_CXX11_TEMPLATE_ALIASES) \
+    && !defined(BOOST_NO_CXX11_HDR_TUPLE)
+#  define BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+#endif
+
 // Setup autolinking
 #if !defined(BOOST_SIGNALS_SOURCE) && !defined(BOOST_ALL_NO_LIB) && !defined(BOOST_SIGNALS_NO_LIB)
 #  define BOOST_LIB_NAME boost_signals
@@ -0,0 +1,743 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_FLAT_SLOT_MAP_HPP
+#define BOOST_SIGNALS_FLAT_SLOT_MAP_HPP
+
+#include <boost/signals/detail/config.hpp>
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/detail/named_slot_map.hpp>
+#include <boost/signals/connection.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost { namespace BOOST_SIGNALS_NAMESPACE { namespace detail {
+
+// A slot stored by value: the connection and the slot function itself.
+// The slot function is released (the optional emptied) when the slot is
+// erased, which leaves a hole behind.
+template<typename SlotFunction>
+struct slot_node {
+  slot_node() {}
+
+  slot_node(const connection& c, const SlotFunction& f)
+    : first(c), second(f)
+  {
+  }
+
+  connection first;
+  optional<SlotFunction> second;
+};
+
+template<typename SlotFunction>
+inline SlotFunction& stored_function(const slot_node<SlotFunction>& node)
+{
+  return const_cast<SlotFunction&>(*node.second);
+}
+
+// The part of a group of slots that does not depend on the slot type.
+// Positions are counted relative to the first slot that was added at the
+// back, so slots added at the front get negative positions and the
+// position of an existing slot never changes while slots are being
+// called.
+class BOOST_SIGNALS_DECL flat_slot_group_base
+{
+public:
+  explicit flat_slot_group_base(const stored_group& n)
+    : name(n), front(0), next(0), index_entry(0)
+  { }
+
+  virtual ~flat_slot_group_base();
+
+  virtual bool empty() const = 0;
+
+  // Destroy and free a group that was created by a group_factory
+  virtual void destroy() = 0;
+
+  stored_group name;
+
+  // The number of slots stored at negative positions
+  std::size_t front;
+
+  // The next group in calling order
+  flat_slot_group_base* next;
+
+  // The entry of the dense group table that refers to this group, if any
+  flat_slot_group_base** index_entry;
+};
+
+// The slots of a single group. Slots live in a deque, so that they are
+// stored in contiguous blocks and never move when other slots are added
+// at either end. The deque, and the group itself, are allocated with the
+// allocator of the signal.
+template<typename SlotFunction, typename Allocator>
+class flat_slot_group : public flat_slot_group_base
+{
+  typedef typename rebind_allocator<Allocator, flat_slot_group>::type
+    group_allocator;
+
+public:
+  typedef slot_node<SlotFunction> node_type;
+  typedef std::deque<node_type,
+                     typename rebind_allocator<Allocator, node_type>::type>
+    slot_deque;
+
+  explicit flat_slot_group(const stored_group& n = stored_group())
+    : flat_slot_group_base(n)
+  { }
+
+  bool empty() const { return slots.empty(); }
+
+  static flat_slot_group_base* create(const stored_group& name)
+  {
+    group_allocator allocator;
+    flat_slot_group* group = allocator.allocate(1);
+    try {
+      new (static_cast<void*>(group)) flat_slot_group(name);
+    }
+    catch(...) {
+      allocator.deallocate(group, 1);
+      throw;
+    }
+    return group;
+  }
+
+  void destroy()
+  {
+    group_allocator allocator;
+    this->~flat_slot_group();
+    allocator.deallocate(this, 1);
+  }
+
+  node_type& at(std::ptrdiff_t pos)
+  { return slots[front + pos]; }
+
+  flat_slot_group* next_group() const
+  { return static_cast<flat_slot_group*>(next); }
+
+  slot_deque slots;
+};
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+class flat_slot_map;
+
+// Provides memory for the group vector of flat_slot_map_base, which does
+// not know the allocator of the signal, in units of group pointers. Each
+// flat_slot_map supplies functions that use its allocator, rebound.
+struct group_vector_memory {
+  flat_slot_group_base** (*allocate)(std::size_t n);
+  void (*deallocate)(flat_slot_group_base** p, std::size_t n);
+};
+
+// A standard allocator that gets its memory from a group_vector_memory
+template<typename T>
+class group_vector_allocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename U>
+  struct rebind { typedef group_vector_allocator<U> other; };
+
+  explicit group_vector_allocator(const group_vector_memory* m) : memory(m)
+  { }
+
+  template<typename U>
+  group_vector_allocator(const group_vector_allocator<U>& other)
+    : memory(other.memory)
+  { }
+
+  pointer allocate(size_type n, const void* = 0)
+  { return reinterpret_cast<pointer>(memory->allocate(units(n))); }
+
+  void deallocate(pointer p, size_type n)
+  {
+    memory->deallocate(reinterpret_cast<flat_slot_group_base**>(p),
+                       units(n));
+  }
+
+  void construct(pointer p, const T& value)
+  { new (static_cast<void*>(p)) T(value); }
+
+  void destroy(pointer p) { p->~T(); }
+
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+  pointer address(reference r) const { return &r; }
+  const_pointer address(const_reference r) const { return &r; }
+
+  const group_vector_memory* memory;
+
+private:
+  // The number of group pointers that hold n objects of type T
+  static std::size_t units(size_type n)
+  {
+    return (n * sizeof(T) + sizeof(flat_slot_group_base*) - 1)
+           / sizeof(flat_slot_group_base*);
+  }
+};
+
+template<typename T, typename U>
+inline bool operator==(const group_vector_allocator<T>& x,
+                       const group_vector_allocator<U>& y)
+{ return x.memory == y.memory; }
+
+template<typename T, typename U>
+inline bool operator!=(const group_vector_allocator<T>& x,
+                       const group_vector_allocator<U>& y)
+{ return x.memory != y.memory; }
+
+template<typename SlotFunction, typename Allocator>
+class flat_slot_map_iterator :
+  public iterator_facade<flat_slot_map_iterator<SlotFunction, Allocator>,
+                         slot_node<SlotFunction>,
+                         forward_traversal_tag>
+{
+  typedef iterator_facade<flat_slot_map_iterator<SlotFunction, Allocator>,
+                          slot_node<SlotFunction>,
+                          forward_traversal_tag> inherited;
+  typedef flat_slot_group<SlotFunction, Allocator> group_type;
+
+public:
+  flat_slot_map_iterator() : group(0), pos(0) { }
+
+  slot_node<SlotFunction>& dereference() const
+  {
+    return group->at(pos);
+  }
+  void increment()
+  {
+    ++pos;
+    if (static_cast<std::size_t>(group->front + pos) == group->slots.size()) {
+      group = group->next_group();
+      init_next_group();
+    }
+  }
+  bool equal(const flat_slot_map_iterator& other) const
+  {
+    return group == other.group && (group == 0 || pos == other.pos);
+  }
+
+#if BOOST_WORKAROUND(_MSC_VER, <= 1900)
+  void decrement() { assert(false); }
+  void advance(typename inherited::difference_type) { assert(false); }
+#endif
+
+private:
+  explicit flat_slot_map_iterator(group_type* g) : group(g), pos(0)
+  { init_next_group(); }
+
+  void init_next_group()
+  {
+    while (group && group->empty()) group = group->next_group();
+    if (group) pos = -static_cast<std::ptrdiff_t>(group->front);
+  }
+
+  group_type* group;
+  std::ptrdiff_t pos;
+
+  template<typename, typename, typename, typename, int>
+  friend class flat_slot_map;
+};
+
+// Orders named groups by their names, which hold values of type Group,
+// comparing the names themselves
+template<typename Group, typename GroupCompare>
+class flat_group_less {
+public:
+  flat_group_less(const GroupCompare& c) : compare(c) { }
+
+  bool operator()(const flat_slot_group_base* g, const Group& name) const
+  { return compare(*static_cast<const Group*>(g->name.get()), name); }
+
+  bool operator()(const Group& name, const flat_slot_group_base* g) const
+  { return compare(name, *static_cast<const Group*>(g->name.get())); }
+
+private:
+  const GroupCompare& compare;
+};
+
+// Indexes the named groups whose names are integers in [0, Size) by
+// name, so that finding them takes neither comparisons nor a search. The
+// table is only allocated once such a group is created.
+template<typename Group, int Size, typename Allocator>
+class dense_group_table : noncopyable
+{
+  typedef typename rebind_allocator<Allocator,
+                                    flat_slot_group_base*>::type
+    allocator_type;
+
+public:
+  dense_group_table() : groups(0) { }
+
+  ~dense_group_table()
+  {
+    if (groups)
+      allocator_type().deallocate(groups, Size);
+  }
+
+  // The entry of the named group, or null if the name is out of range or
+  // the table has not been allocated yet
+  flat_slot_group_base** find(const Group& name) const
+  { return (groups && covers(name))? &groups[index(name)] : 0; }
+
+  // The entry of the named group, allocating the table if needed, or
+  // null if the name is out of range
+  flat_slot_group_base** entry(const Group& name)
+  {
+    if (!covers(name))
+      return 0;
+
+    if (!groups) {
+      groups = allocator_type().allocate(Size);
+      std::fill(groups, groups + Size,
+                static_cast<flat_slot_group_base*>(0));
+    }
+    return &groups[index(name)];
+  }
+
+  void clear()
+  {
+    if (groups)
+      std::fill(groups, groups + Size,
+                static_cast<flat_slot_group_base*>(0));
+  }
+
+private:
+  static bool covers(const Group& name)
+  { return !(name < Group(0)) && name < Group(Size); }
+
+  static std::size_t index(const Group& name)
+  { return static_cast<std::size_t>(name); }
+
+  flat_slot_group_base** groups;
+};
+
+template<typename Group, typename Allocator>
+class dense_group_table<Group, 0, Allocator>
+{
+public:
+  flat_slot_group_base** find(const Group&) const { return 0; }
+  flat_slot_group_base** entry(const Group&) { return 0; }
+  void clear() { }
+};
+
+// The group bookkeeping of flat_slot_map, which does not depend on the
+// slot type: named groups are kept in a vector sorted by name, and every
+// group is linked to the next one in calling order. The vector gets its
+// memory from the allocator of the signal, through the given
+// group_vector_memory.
+class BOOST_SIGNALS_DECL flat_slot_map_base : public slot_map_base
+{
+protected:
+  typedef std::vector<flat_slot_group_base*,
+                      group_vector_allocator<flat_slot_group_base*> >
+    group_vector;
+
+  flat_slot_map_base(flat_slot_group_base* front_group,
+                     const group_vector_memory& memory);
+  ~flat_slot_map_base();
+
+  // Insert a newly created named group at the given position of the
+  // group vector and link it into calling order. Destroys the group if
+  // it cannot be inserted.
+  void insert_group(group_vector::iterator pos, flat_slot_group_base* group);
+
+  // Unlink and destroy the named groups that no longer contain any slots.
+  // Does not throw.
+  void remove_empty_groups();
+
+  // The first group in calling order (ungrouped slots connected at_front)
+  flat_slot_group_base* first_group;
+
+  // Named groups, in calling order
+  group_vector groups;
+
+  // Number of slots stored, and how many of those are holes
+  std::size_t slot_count;
+  std::size_t hole_count;
+
+  // True while slots must stay where they are
+  bool compacting;
+};
+
+// Slot container that keeps slots in contiguous storage: each group
+// stores its slots, including the slot functions, inline in a deque.
+// Erasing a slot only releases the slot function; the hole it leaves is
+// skipped by the slot call iterator and reclaimed once holes make up half
+// of the container, so disconnecting is amortized constant time. The
+// position data of each slot is the address of its slot_node, which is
+// updated whenever the slot is moved. Named groups are looked up with
+// the group comparison of the signal itself, called directly, except for
+// groups named by integers in [0, DenseGroups), which are found through
+// a dense_group_table.
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups = 0>
+class flat_slot_map : public flat_slot_map_base
+{
+  typedef flat_slot_group<SlotFunction, Allocator> group_type;
+  typedef slot_node<SlotFunction> node_type;
+  typedef flat_group_less<Group, GroupCompare> group_less;
+  typedef dense_group_table<Group, DenseGroups, Allocator> group_table;
+
+public:
+  typedef flat_slot_map_iterator<SlotFunction, Allocator> iterator;
+  typedef GroupCompare group_compare_type;
+
+  flat_slot_map(const GroupCompare& c)
+    : flat_slot_map_base(&front_group, group_memory),
+      compare(c),
+      front_group(stored_group(stored_group::sk_front)),
+      back_group(stored_group(stored_group::sk_back))
+  {
+    front_group.next = &back_group;
+  }
+
+  ~flat_slot_map() { clear(); }
+
+  iterator begin() { return iterator(&front_group); }
+  iterator end() { return iterator(); }
+
+  void clear();
+  void* insert_slot(const stored_group& name, const connection& con,
+                    const void* slot, connect_position at);
+  void insert_slots(const stored_group& name, connect_position at,
+                    slot_source& source);
+  void erase_slot(void* position);
+  void release_position(void*) { }
+  void group_connections(const stored_group& name,
+                         std::vector<connection>& out);
+  void connections(std::vector<connection>& out);
+  void remove_disconnected_slots();
+
+private:
+  static const Group& group_name(const stored_group& name)
+  { return *static_cast<const Group*>(name.get()); }
+
+  typedef typename rebind_allocator<Allocator,
+                                    flat_slot_group_base*>::type
+    group_pointer_allocator;
+
+  static flat_slot_group_base** allocate_groups(std::size_t n)
+  { return group_pointer_allocator().allocate(n); }
+
+  static void deallocate_groups(flat_slot_group_base** p, std::size_t n)
+  { group_pointer_allocator().deallocate(p, n); }
+
+  static const group_vector_memory group_memory;
+
+  // Find the named group, or null if it does not exist
+  group_type* find_group(const stored_group& name) const
+  {
+    const Group& key = group_name(name);
+    if (flat_slot_group_base** entry = table.find(key))
+      return static_cast<group_type*>(*entry);
+
+    group_vector::const_iterator pos =
+      std::lower_bound(groups.begin(), groups.end(), key,
+                       group_less(compare));
+    if (pos == groups.end() || compare(key, group_name((*pos)->name)))
+      return 0;
+    return static_cast<group_type*>(*pos);
+  }
+
+  // Find the group into which a slot is inserted, creating it if needed
+  group_type* insertion_group(const stored_group& name, connect_position at)
+  {
+    if (name.empty())
+      return (at == at_front)? &front_group : &back_group;
+
+    const Group& key = group_name(name);
+    flat_slot_group_base** entry = table.entry(key);
+    if (entry && *entry)
+      return static_cast<group_type*>(*entry);
+
+    group_vector::iterator pos =
+      std::lower_bound(groups.begin(), groups.end(), key,
+                       group_less(compare));
+    if (!entry && pos != groups.end()
+        && !compare(key, group_name((*pos)->name)))
+      return static_cast<group_type*>(*pos);
+
+    // The name may only be borrowed, so the group keeps its own copy
+    group_type* group = static_cast<group_type*>(
+      group_type::create(stored_group(key, Allocator())));
+    insert_group(pos, group);
+    if (entry) {
+      *entry = group;
+      group->index_entry = entry;
+    }
+    return group;
+  }
+
+  // Insert a slot into the given group, and return its position data
+  void* insert_into(group_type* group, const connection& con,
+                    const void* slot, connect_position at);
+
+  // Release the slot function of a disconnected slot. The slot function
+  // may reenter the map when it is destroyed, so slots are held in place
+  // meanwhile.
+  void release(node_type& node);
+
+  // Remove the holes left by erased slots and drop empty groups. Slots
+  // that are disconnected but not erased yet stay, since the signal will
+  // still erase them (from another thread, if the signal has a lock).
+  void compact();
+
+  GroupCompare compare;
+  group_table table;
+
+  // Ungrouped slots connected at_front and at_back, respectively
+  group_type front_group;
+  group_type back_group;
+};
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+const group_vector_memory
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::group_memory = {
+  &flat_slot_map::allocate_groups,
+  &flat_slot_map::deallocate_groups
+};
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+                   DenseGroups>::clear()
+{
+  // Take the slots out of the map before destroying them, so that the
+  // map is consistent if a slot destructor reenters it.
+  group_vector old_groups(groups.get_allocator());
+  old_groups.swap(groups);
+  typename group_type::slot_deque old_front, old_back;
+  old_front.swap(front_group.slots);
+  old_back.swap(back_group.slots);
+
+  front_group.front = back_group.front = 0;
+  front_group.next = &back_group;
+  slot_count = hole_count = 0;
+  table.clear();
+
+  for (group_vector::iterator g = old_groups.begin(); g != old_groups.end();
+       ++g)
+    (*g)->destroy();
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void*
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::insert_slot(
+  const stored_group& name, const connection& con, const void* slot,
+  connect_position at)
+{
+  return insert_into(insertion_group(name, at), con, slot, at);
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::insert_slots(
+  const stored_group& name, connect_position at, slot_source& source)
+{
+  group_type* group = insertion_group(name, at);
+  try {
+    const connection* con;
+    const void* slot;
+    while (source.next(con, slot))
+      source.inserted(insert_into(group, *con, slot, at));
+  }
+  catch(...) {
+    if (group->empty())
+      remove_empty_groups();
+    throw;
+  }
+
+  if (group->empty())
+    remove_empty_groups();
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void*
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::insert_into(
+  group_type* group, const connection& con, const void* slot,
+  connect_position at)
+{
+  const SlotFunction& f = *static_cast<const SlotFunction*>(slot);
+  node_type* result;
+  if (at == at_front) {
+    group->slots.push_front(node_type(con, f));
+    ++group->front;
+    result = &group->slots.front();
+  }
+  else {
+    group->slots.push_back(node_type(con, f));
+    result = &group->slots.back();
+  }
+  ++slot_count;
+
+  // Make the copy of the connection in the map disconnect when it is
+  // destroyed.
+  result->first.set_controlling();
+  return result;
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::release(
+  node_type& node)
+{
+  bool was_compacting = compacting;
+  compacting = true;
+  node.second = none;
+  compacting = was_compacting;
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::erase_slot(
+  void* position)
+{
+  // Release the slot function now, as it may hold on to resources, but
+  // leave the hole in place until enough holes have accumulated.
+  ++hole_count;
+  release(*static_cast<node_type*>(position));
+
+  if (hole_count * 2 > slot_count)
+    compact();
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::group_connections(
+  const stored_group& name, std::vector<connection>& out)
+{
+  group_type* group = find_group(name);
+  if (!group)
+    return;
+
+  for (std::size_t i = 0; i < group->slots.size(); ++i) {
+    out.push_back(group->slots[i].first);
+    out.back().set_controlling(false);
+  }
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void
+flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+              DenseGroups>::connections(
+  std::vector<connection>& out)
+{
+  for (iterator i = begin(); i != end(); ++i) {
+    out.push_back(i->first);
+    out.back().set_controlling(false);
+  }
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+                   DenseGroups>::remove_disconnected_slots()
+{
+  if (compacting)
+    return;
+
+  // Slots that were disconnected while slots were being called still hold
+  // their slot functions; release them before anything moves.
+  for (group_type* g = &front_group; g; g = g->next_group()) {
+    for (std::size_t i = 0; i < g->slots.size(); ++i) {
+      if (!g->slots[i].first.connected() && g->slots[i].second)
+        release(g->slots[i]);
+    }
+  }
+
+  compact();
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator, int DenseGroups>
+void flat_slot_map<SlotFunction, Group, GroupCompare, Allocator,
+                   DenseGroups>::compact()
+{
+  if (compacting)
+    return;
+
+  compacting = true;
+  try {
+    for (group_type* g = &front_group; g; g = g->next_group()) {
+      typename group_type::slot_deque& slots = g->slots;
+      std::size_t live = 0;
+      for (std::size_t i = 0; i < slots.size(); ++i) {
+        if (!slots[i].second) continue;
+
+        // Move the slot function first: if that throws, the slot stays
+        // where it was
+        if (i != live) {
+          swap(slots[live].second, slots[i].second);
+          slots[live].first.swap(slots[i].first);
+        }
+
+        // The slot has (possibly) moved, so update its position data
+        slots[live].first.get_connection()->signal_data = &slots[live];
+        ++live;
+      }
+
+      std::size_t removed = slots.size() - live;
+      slots.erase(slots.begin() + live, slots.end());
+      g->front = 0;
+      slot_count -= removed;
+    }
+  }
+  catch(...) {
+    // Every slot is still in a consistent place, but some holes remain;
+    // they will be compacted later.
+    compacting = false;
+    throw;
+  }
+
+  remove_empty_groups();
+  hole_count = 0;
+  compacting = false;
+}
+
+} } }
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_FLAT_SLOT_MAP_HPP
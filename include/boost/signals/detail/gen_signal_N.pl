@@ -15,110 +15,138 @@ if ($#ARGV < 0) {
   exit;
 }
 
+# Lines are wrapped to stay shorter than this
+$maxColumns = 80;
+
+# Join the items with ", ", starting with $first and starting each
+# continuation line with $indent, and end with $last
+sub wrap {
+  my ($first, $indent, $last, @items) = @_;
+  my $result = "";
+  my $line = $first;
+  for (my $i = 0; $i <= $#items; ++$i) {
+    my $item = $items[$i] . ($i < $#items ? "," : $last);
+    if ($line ne $first && $line ne $indent
+        && length($line) + 1 + length($item) >= $maxColumns) {
+      $result .= "$line\n";
+      $line = $indent;
+    }
+    elsif ($line ne $first && $line ne $indent) {
+      $line .= " ";
+    }
+    $line .= $item;
+  }
+  return $result . "$line\n";
+}
 
 $totalNumArgs = $ARGV[0];
 for ($numArgs = 0; $numArgs <= $totalNumArgs; ++$numArgs) {
   open OUT, ">signal$numArgs.hpp";
   print OUT "// Boost.Signals library\n";
-  print OUT "//\n";
-  print OUT "// Copyright (C) 2001 Doug Gregor (gregod\@cs.rpi.edu)\n";
-  print OUT "//\n";
-  print OUT "// Permission to copy, use, sell and distribute this software is granted\n";
-  print OUT "// provided this copyright notice appears in all copies.\n";
-  print OUT "// Permission to modify the code and to distribute modified code is granted\n";
-  print OUT "// provided this copyright notice appears in all copies, and a notice\n";
-  print OUT "// that the code was modified is included with the copyright notice.\n";
-  print OUT "//\n";
-  print OUT "// This software is provided \"as is\" without express or implied warranty,\n";
-  print OUT "// and with no claim as to its suitability for any purpose.\n";
-  print OUT " \n";
+  print OUT "\n";
+  print OUT "// Copyright Douglas Gregor 2001-2003. Use, modification and\n";
+  print OUT "// distribution is subject to the Boost Software License, Version\n";
+  print OUT "// 1.0. (See accompanying file LICENSE_1_0.txt or copy at\n";
+  print OUT "// http://www.boost.org/LICENSE_1_0.txt)\n";
+  print OUT "\n";
   print OUT "// For more information, see http://www.boost.org\n";
   print OUT "\n";
   print OUT "#ifndef BOOST_SIGNALS_SIGNAL" . $numArgs . "_HEADER\n";
-  print OUT "#define BOOST_SIGNALS_SIGNAL" , $numArgs . "_HEADER\n";
+  print OUT "#define BOOST_SIGNALS_SIGNAL" . $numArgs . "_HEADER\n";
+  print OUT "\n";
+  print OUT "#include <boost/signals/detail/config.hpp>\n";
   print OUT "\n";
-  print OUT "#define BOOST_SIGNALS_NUM_ARGS $numArgs\n";
 
-  $templateParms = "";
+  @types = ();
   for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $templateParms .= ", ";
-    }
-    $templateParms .= "typename T$i";
+    push @types, "T$i";
   }
-  print OUT "#define BOOST_SIGNALS_TEMPLATE_PARMS $templateParms\n";
 
-  $_ = $templateParms;
-  s/typename //g;
-  $templateArgs = $_;
-  print OUT "#define BOOST_SIGNALS_TEMPLATE_ARGS $templateArgs\n";
-
-  $parms = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $parms .= ", ";
-    }
-    $parms .= "T$i a$i";
+  # With variadic templates, signalN is an alias of variadic_signal
+  print OUT "#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES\n";
+  print OUT "#  include <boost/signals/detail/variadic_signal.hpp>\n";
+  print OUT "#  include <boost/function/function$numArgs.hpp>\n";
+  print OUT "\n";
+  print OUT "namespace boost {\n";
+  print OUT wrap("  template<", "           ", ",",
+                 map { "typename $_" } ("R", @types));
+  print OUT "           typename Combiner = last_value<R>,\n";
+  print OUT "           typename Group = int,\n";
+  print OUT "           typename GroupCompare = std::less<Group>,\n";
+  $slotFunction = "function$numArgs<" . join(", ", "R", @types) . ">,";
+  $line = "           typename SlotFunction = $slotFunction";
+  if (length($line) < $maxColumns) {
+    print OUT "$line\n";
   }
-  print OUT "#define BOOST_SIGNALS_PARMS $parms\n";
-
-  $args = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $args .= ", ";
-    }
-    $args .= "a$i";
+  else {
+    print OUT "           typename SlotFunction =\n";
+    print OUT "             $slotFunction\n";
   }
-  print OUT "#define BOOST_SIGNALS_ARGS $args\n";
-
-  $boundArgs = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $boundArgs .= ", ";
-    }
-    $boundArgs .= "args->a$i";
+  print OUT "           typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,\n";
+  print OUT "           typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,\n";
+  print OUT "           typename Allocator = std::allocator<void> >\n";
+  print OUT "  using signal$numArgs =\n";
+  print OUT "    BOOST_SIGNALS_NAMESPACE::detail::variadic_signal<\n";
+  $signature = "R (" . join(", ", @types) . ")";
+  $line = "      $signature, Combiner, Group, GroupCompare, SlotFunction,";
+  if (length($line) < $maxColumns) {
+    print OUT "$line\n";
+    print OUT "      SlotStorage, LockPolicy, Allocator>;\n";
   }
-  print OUT "#define BOOST_SIGNALS_BOUND_ARGS $boundArgs\n";
-
-  $argsAsMembers = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    $argsAsMembers .= "T$i a$i;";
+  else {
+    print OUT "      $signature,\n";
+    print OUT "      Combiner, Group, GroupCompare, SlotFunction, SlotStorage,\n";
+    print OUT "      LockPolicy, Allocator>;\n";
   }
-  print OUT "#define BOOST_SIGNALS_ARGS_AS_MEMBERS $argsAsMembers\n";
+  print OUT "} // end namespace boost\n";
 
-  $copyParms = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $copyParms .= ", ";
-    }
-    $copyParms .= "T$i ia$i";
-  }
-  print OUT "#define BOOST_SIGNALS_COPY_PARMS $copyParms\n";
+  # Otherwise, signal_template.hpp is expanded for N arguments
+  print OUT "#else\n";
+  print OUT "#define BOOST_SIGNALS_NUM_ARGS $numArgs\n";
 
-  $initArgs = "";
-  if ($numArgs > 0) {
-      $initArgs = ":";
-  }
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    if ($i > 1) {
-      $initArgs .= ", ";
-    }
-    $initArgs .= "a$i(ia$i)";
-  }
-  print OUT "#define BOOST_SIGNALS_INIT_ARGS $initArgs\n";
+  $templateParms = join(", ", map { "typename $_" } @types);
+  print OUT "#define BOOST_SIGNALS_TEMPLATE_PARMS" . ($numArgs ? " " : "")
+            . "$templateParms\n";
 
-  $argTypes = "";
-  for ($i = 1; $i <= $numArgs; ++$i) {
-    $argTypes .= "typedef T$i arg". ($i+1) . "_type; ";
-  }
+  $templateArgs = join(", ", @types);
+  print OUT "#define BOOST_SIGNALS_TEMPLATE_ARGS" . ($numArgs ? " " : "")
+            . "$templateArgs\n";
+
+  $parms = join(", ", map { "T$_ a$_" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_PARMS" . ($numArgs ? " " : "") . "$parms\n";
+
+  $args = join(", ", map { "a$_" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_ARGS" . ($numArgs ? " " : "") . "$args\n";
+
+  $boundArgs = join(", ", map { "args->a$_" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_BOUND_ARGS" . ($numArgs ? " " : "")
+            . "$boundArgs\n";
+
+  # The arguments of a call are bound by reference, not copied
+  $argsAsMembers = join("",
+    map { "typename add_reference<T$_>::type a$_;" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_ARGS_AS_MEMBERS" . ($numArgs ? " " : "")
+            . "$argsAsMembers\n";
+
+  $refParms = join(", ",
+    map { "typename add_reference<T$_>::type ia$_" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_REF_PARMS" . ($numArgs ? " " : "")
+            . "$refParms\n";
+
+  $initArgs = ($numArgs ? ":" : "")
+              . join(", ", map { "a$_(ia$_)" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_INIT_ARGS" . ($numArgs ? " " : "")
+            . "$initArgs\n";
 
-  print OUT "#define BOOST_SIGNALS_ARG_TYPES $argTypes\n";
+  $argTypes = join(" ", map { "typedef T$_ arg$_" . "_type;" } 1 .. $numArgs);
+  print OUT "#define BOOST_SIGNALS_ARG_TYPES" . ($numArgs ? " " : "")
+            . "$argTypes\n";
   print OUT "\n";
   print OUT "#include <boost/signals/signal_template.hpp>\n";
   print OUT "\n";
   print OUT "#undef BOOST_SIGNALS_ARG_TYPES\n";
   print OUT "#undef BOOST_SIGNALS_INIT_ARGS\n";
-  print OUT "#undef BOOST_SIGNALS_COPY_PARMS\n";
+  print OUT "#undef BOOST_SIGNALS_REF_PARMS\n";
   print OUT "#undef BOOST_SIGNALS_ARGS_AS_MEMBERS\n";
   print OUT "#undef BOOST_SIGNALS_BOUND_ARGS\n";
   print OUT "#undef BOOST_SIGNALS_ARGS\n";
@@ -126,6 +154,7 @@ for ($numArgs = 0; $numArgs <= $totalNumArgs; ++$numArgs) {
   print OUT "#undef BOOST_SIGNALS_TEMPLATE_ARGS\n";
   print OUT "#undef BOOST_SIGNALS_TEMPLATE_PARMS\n";
   print OUT "#undef BOOST_SIGNALS_NUM_ARGS\n";
+  print OUT "#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES\n";
   print OUT "\n";
   print OUT "#endif // BOOST_SIGNALS_SIGNAL" . $numArgs . "_HEADER\n";
   close OUT;
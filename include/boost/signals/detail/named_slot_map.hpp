@@ -14,11 +14,15 @@
 #include <boost/signals/detail/signals_common.hpp>
 #include <boost/signals/connection.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/function/function2.hpp>
 #include <boost/iterator/iterator_facade.hpp>
+#include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace boost { namespace BOOST_SIGNALS_NAMESPACE {
 
@@ -36,6 +40,32 @@ class stored_group
   template<typename T>
   stored_group(const T& p_group) : kind(sk_group), group(new T(p_group)) { }
 
+  // Stores the group name with the given allocator
+  template<typename T, typename Allocator>
+  stored_group(const T& p_group, const Allocator& allocator)
+    : kind(sk_group), group(boost::allocate_shared<T>(allocator, p_group))
+  { }
+
+  // Refers to the group name without copying it. Only valid as long as
+  // the name itself; slot containers store an owned copy instead.
+  template<typename T>
+  static stored_group borrow(const T& p_group)
+  {
+    stored_group result(sk_group);
+    result.group = shared_ptr<void>(shared_ptr<void>(),
+                                    const_cast<T*>(&p_group));
+    return result;
+  }
+
+  // A copy that owns its group name, which holds a value of type T
+  template<typename T, typename Allocator>
+  stored_group owned(const Allocator& allocator) const
+  {
+    if (kind != sk_group)
+      return *this;
+    return stored_group(*static_cast<const T*>(group.get()), allocator);
+  }
+
   bool is_front() const { return kind == sk_front; }
   bool is_back() const { return kind == sk_back; }
   bool empty() const { return kind == sk_empty; }
@@ -47,7 +77,8 @@ class stored_group
   shared_ptr<void> group;
 };
 
-typedef function2<bool, stored_group, stored_group> compare_type;
+typedef function2<bool, const stored_group&, const stored_group&>
+  compare_type;
 
 // This function object bridges from a pair of any objects that hold
 // values of type Key to the underlying function object that compares
@@ -77,6 +108,87 @@ private:
   Compare comp;
 };
 
+// Supplies slots to slot_map_base::insert_slots, one at a time
+class BOOST_SIGNALS_DECL slot_source
+{
+public:
+  // Provide the connection and the slot function of the next slot, or
+  // return false once there are no slots left
+  virtual bool next(const connection*& con, const void*& slot) = 0;
+
+  // The slot that was provided last has been inserted, with the given
+  // position data
+  virtual void inserted(void* position) = 0;
+
+protected:
+  ~slot_source() { }
+};
+
+// Interface through which signal_base_impl manages a slot container. The
+// container type itself is chosen per signal type (see slot_storage.hpp);
+// the signalN templates iterate the concrete container directly, so only
+// the connection management operations go through this interface.
+class BOOST_SIGNALS_DECL slot_map_base
+{
+public:
+  virtual ~slot_map_base();
+
+  // Remove all slots
+  virtual void clear() = 0;
+
+  // Insert a slot and make the stored copy of the connection controlling.
+  // Returns the position data handed back to erase_slot and
+  // release_position when the slot is disconnected; it may be kept in the
+  // slot_position of the connection.
+  // The slot is a pointer to the slot function, which the container
+  // copies.
+  virtual void* insert_slot(const stored_group& name, const connection& con,
+                            const void* slot, connect_position at) = 0;
+
+  // Insert every slot of the source into the same group, as if by
+  // insert_slot, but looking the group up only once. The slots need not
+  // be visible until insert_slots returns. If an exception is thrown,
+  // the slots reported as inserted may or may not have been kept.
+  virtual void insert_slots(const stored_group& name, connect_position at,
+                            slot_source& source);
+
+  // Remove the slot at the given position. Only called when no slot
+  // iterators are live.
+  virtual void erase_slot(void* position) = 0;
+
+  // The slot at the given position has been disconnected, and the
+  // position data will not be used again
+  virtual void release_position(void* position) = 0;
+
+  // Append non-controlling copies of the connections of the slots in the
+  // given group, or of every slot, to the given vector. The signal
+  // disconnects slots through these, as disconnecting a slot may remove
+  // it from the container.
+  virtual void group_connections(const stored_group& name,
+                                 std::vector<connection>& out) = 0;
+  virtual void connections(std::vector<connection>& out) = 0;
+
+  // Remove all of the slots that have been disconnected
+  virtual void remove_disconnected_slots() = 0;
+
+  // Whether removing count disconnected slots out of size slots with
+  // remove_disconnected_slots is cheaper than erasing them one at a time.
+  // By default it is, when they make up a good part of the container.
+  virtual bool prefer_batch_erase(std::size_t count, std::size_t size) const
+  { return count > 1 && count * 4 >= size; }
+};
+
+// Creates a slot container, given the group comparison object of the
+// signal, which has type SlotMap::group_compare_type
+typedef slot_map_base* (*slot_map_factory)(const void* group_compare);
+
+template<typename SlotMap>
+slot_map_base* create_slot_map(const void* group_compare)
+{
+  typedef typename SlotMap::group_compare_type group_compare_type;
+  return new SlotMap(*static_cast<const group_compare_type*>(group_compare));
+}
+
 class BOOST_SIGNALS_DECL named_slot_map_iterator :
   public iterator_facade<named_slot_map_iterator,
                          connection_slot_pair,
@@ -157,7 +269,9 @@ private:
   friend class named_slot_map;
 };
 
-class BOOST_SIGNALS_DECL named_slot_map
+// Slot container that keeps each group's slots in a std::list, indexed
+// by a std::map from group to list
+class BOOST_SIGNALS_DECL named_slot_map : public slot_map_base
 {
 public:
   typedef named_slot_map_iterator iterator;
@@ -169,10 +283,26 @@ public:
   iterator end();
   iterator insert(const stored_group& name, const connection& con,
                   const any& slot, connect_position at);
-  void disconnect(const stored_group& name);
   void erase(iterator pos);
   void remove_disconnected_slots();
 
+  void erase_slot(void* position);
+  void release_position(void* position);
+  void group_connections(const stored_group& name,
+                         std::vector<connection>& out);
+  void connections(std::vector<connection>& out);
+
+protected:
+  // Insert a slot whose slot function has been wrapped into an any, and
+  // return its position data
+  void* store_slot(const stored_group& name, const connection& con,
+                   const any& slot, connect_position at);
+
+  // Insert the slots of the source, wrapping each slot function into an
+  // any with the given function
+  void store_slots(const stored_group& name, connect_position at,
+                   slot_source& source, any (*wrap)(const void*));
+
 private:
   typedef std::list<connection_slot_pair> group_list;
   typedef std::map<stored_group, group_list, compare_type> slot_container_type;
@@ -183,10 +313,56 @@ private:
   {
     return (group->second.empty() && group != groups.begin() && group != back);
   }
+
+  // Find the group into which a slot is inserted, creating it if needed
+  group_iterator insertion_group(const stored_group& name,
+                                 connect_position at);
+
+  // Insert a slot into the given group
+  iterator insert_into(group_iterator group, const connection& con,
+                       const any& slot, connect_position at);
+
+  // Insert a slot into the given group and store its insertion point,
+  // and return its position data
+  void* store_position(const connection& con, const any& slot,
+                       connect_position at, group_iterator group);
+
   slot_container_type groups;
   group_iterator back;
 };
 
+// named_slot_map for a particular slot function and group type. Group
+// names are allocated with the given allocator.
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+class node_slot_map : public named_slot_map
+{
+public:
+  typedef GroupCompare group_compare_type;
+
+  node_slot_map(const GroupCompare& compare)
+    : named_slot_map(group_bridge_compare<GroupCompare, Group>(compare))
+  { }
+
+  void* insert_slot(const stored_group& name, const connection& con,
+                    const void* slot, connect_position at)
+  {
+    return store_slot(name.owned<Group>(Allocator()), con, wrap(slot), at);
+  }
+
+  void insert_slots(const stored_group& name, connect_position at,
+                    slot_source& source)
+  {
+    store_slots(name.owned<Group>(Allocator()), at, source, &wrap);
+  }
+
+private:
+  static any wrap(const void* slot)
+  {
+    return any(*static_cast<const SlotFunction*>(slot));
+  }
+};
+
 } } }
 
 #endif // BOOST_SIGNALS_NAMED_SLOT_MAP_HPP
@@ -0,0 +1,167 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_REDUCTION_HEADER
+#define BOOST_SIGNALS_REDUCTION_HEADER
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/atomic.hpp>
+#include <cstddef>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // Reductions of an array of results. Each keeps four independent
+      // accumulators, so that successive elements do not wait for each
+      // other and the compiler can keep the accumulators in a single
+      // vector register.
+      template<typename T>
+      T reduce_sum(const T* values, std::size_t n)
+      {
+        T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+          s0 += values[i];
+          s1 += values[i + 1];
+          s2 += values[i + 2];
+          s3 += values[i + 3];
+        }
+        for (; i < n; ++i)
+          s0 += values[i];
+        return (s0 + s1) + (s2 + s3);
+      }
+
+      // Requires n > 0
+      template<typename T>
+      T reduce_min(const T* values, std::size_t n)
+      {
+        T m0 = values[0], m1 = values[0], m2 = values[0], m3 = values[0];
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+          m0 = values[i] < m0? values[i] : m0;
+          m1 = values[i + 1] < m1? values[i + 1] : m1;
+          m2 = values[i + 2] < m2? values[i + 2] : m2;
+          m3 = values[i + 3] < m3? values[i + 3] : m3;
+        }
+        for (; i < n; ++i)
+          m0 = values[i] < m0? values[i] : m0;
+        m0 = m1 < m0? m1 : m0;
+        m2 = m3 < m2? m3 : m2;
+        return m2 < m0? m2 : m0;
+      }
+
+      // Requires n > 0
+      template<typename T>
+      T reduce_max(const T* values, std::size_t n)
+      {
+        T m0 = values[0], m1 = values[0], m2 = values[0], m3 = values[0];
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+          m0 = m0 < values[i]? values[i] : m0;
+          m1 = m1 < values[i + 1]? values[i + 1] : m1;
+          m2 = m2 < values[i + 2]? values[i + 2] : m2;
+          m3 = m3 < values[i + 3]? values[i + 3] : m3;
+        }
+        for (; i < n; ++i)
+          m0 = m0 < values[i]? values[i] : m0;
+        m0 = m0 < m1? m1 : m0;
+        m2 = m2 < m3? m3 : m2;
+        return m0 < m2? m2 : m0;
+      }
+
+      // The position of the first of the largest elements. Requires
+      // n > 0
+      template<typename T>
+      std::size_t reduce_argmax(const T* values, std::size_t n)
+      {
+        T largest = reduce_max(values, n);
+        std::size_t i = 0;
+        while (values[i] < largest)
+          ++i;
+        return i;
+      }
+
+      // Base class of the combiners that store the results of the slots
+      // in a buffer, which is kept from one call to the next, and then
+      // reduce the buffer as a whole. A call that finds the buffer in use,
+      // by a slot that calls the signal again or by another thread, stores
+      // its results in a vector of its own instead.
+      template<typename T>
+      class result_buffer {
+      public:
+        explicit result_buffer(std::size_t capacity) : busy(false)
+        {
+          values.reserve(capacity);
+        }
+
+        // Copies get a buffer of the same capacity
+        result_buffer(const result_buffer& other) : busy(false)
+        {
+          values.reserve(other.values.capacity());
+        }
+
+        result_buffer& operator=(const result_buffer& other)
+        {
+          values.reserve(other.values.capacity());
+          return *this;
+        }
+
+      protected:
+        // Calls the slots, storing their results, and returns the result
+        // of the kernel on them, or empty if there are none
+        template<typename R, typename InputIterator>
+        R reduce(InputIterator first, InputIterator last,
+                 R (*kernel)(const T*, std::size_t), R empty) const
+        {
+          if (busy.exchange(true, memory_order_acquire)) {
+            std::vector<T> own;
+            return reduce_into(own, first, last, kernel, empty);
+          }
+
+          release_on_exit release = { &busy };
+          return reduce_into(values, first, last, kernel, empty);
+        }
+
+      private:
+        struct release_on_exit {
+          ~release_on_exit() { busy->store(false, memory_order_release); }
+          atomic<bool>* busy;
+        };
+
+        template<typename R, typename InputIterator>
+        static R reduce_into(std::vector<T>& results,
+                             InputIterator first, InputIterator last,
+                             R (*kernel)(const T*, std::size_t), R empty)
+        {
+          results.clear();
+          for (; first != last; ++first)
+            results.push_back(*first);
+          return results.empty()? empty
+                                : kernel(&results[0], results.size());
+        }
+
+        mutable std::vector<T> values;
+
+        // Whether a call is using values
+        mutable atomic<bool> busy;
+      };
+    } // end namespace detail
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_REDUCTION_HEADER
@@ -13,12 +13,19 @@
 #include <boost/signals/detail/config.hpp>
 #include <boost/signals/detail/signals_common.hpp>
 #include <boost/signals/detail/named_slot_map.hpp>
+#include <boost/signals/detail/flat_slot_map.hpp>
 #include <boost/signals/connection.hpp>
 #include <boost/signals/trackable.hpp>
 #include <boost/signals/slot.hpp>
+#include <boost/signals/lock_policy.hpp>
 #include <boost/smart_ptr.hpp>
+#include <boost/atomic.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/detail/atomic_count.hpp>
 #include <boost/function/function2.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iterator/iterator_traits.hpp>
+#include <boost/optional.hpp>
 #include <utility>
 #include <vector>
 
@@ -29,8 +36,85 @@
 namespace boost {
   namespace BOOST_SIGNALS_NAMESPACE {
     namespace detail {
+      // The lock of a signal, as chosen by its LockPolicy. Signals whose
+      // LockPolicy is null_lock have no lock at all.
+      class BOOST_SIGNALS_DECL signal_lock {
+      public:
+        virtual ~signal_lock();
+
+        virtual void lock() = 0;
+        virtual void unlock() = 0;
+        virtual void lock_shared() = 0;
+        virtual void unlock_shared() = 0;
+      };
+
+      template<typename LockPolicy>
+      class signal_lock_impl : public signal_lock {
+      public:
+        void lock() { policy.lock(); }
+        void unlock() { policy.unlock(); }
+        void lock_shared() { policy.lock_shared(); }
+        void unlock_shared() { policy.unlock_shared(); }
+
+      private:
+        LockPolicy policy;
+      };
+
+      typedef signal_lock* (*signal_lock_factory)();
+
+      template<typename LockPolicy>
+      signal_lock* create_signal_lock()
+      {
+        return new signal_lock_impl<LockPolicy>;
+      }
+
+      template<>
+      inline signal_lock* create_signal_lock<null_lock>()
+      {
+        return 0;
+      }
+
+      // The slots connected by signal_base_impl::connect_slots
+      class BOOST_SIGNALS_DECL slot_sequence {
+      public:
+        // Make the next slot, and provide its slot function and data, or
+        // return false once there are no slots left. The slot lives until
+        // the next call.
+        virtual bool next(const void*& slot, slot_base::data_t*& data) = 0;
+
+      protected:
+        ~slot_sequence() {}
+      };
+
+      // The slots made from the elements of a range
+      template<typename Slot, typename InputIterator>
+      class slot_range : public slot_sequence {
+      public:
+        slot_range(InputIterator f, InputIterator l) : first(f), last(l) {}
+
+        bool next(const void*& slot, slot_base::data_t*& data)
+        {
+          if (first == last)
+            return false;
+
+          current = none;
+          current.emplace(*first++);
+          slot = &current->get_slot_function();
+          data = current->get_data().get();
+          return true;
+        }
+
+      private:
+        InputIterator first;
+        InputIterator last;
+        optional<Slot> current;
+      };
+
       // Must be constructed before calling the slots, because it safely
-      // manages call depth
+      // manages call depth. Slots are neither moved nor erased while the
+      // call depth is not zero, so the lock of a signal that has one is
+      // only taken to change the call depth, and is not held while the
+      // slots are called.
       class BOOST_SIGNALS_DECL call_notification {
       public:
         call_notification(const shared_ptr<signal_base_impl>&);
@@ -45,20 +129,18 @@ namespace boost {
       public:
         friend class call_notification;
 
-        typedef function2<bool, stored_group, stored_group> compare_type;
-
         // Make sure that an exception does not cause the "clearing" flag to
         // remain set
         class temporarily_set_clearing {
         public:
           temporarily_set_clearing(signal_base_impl* b) : base(b)
           {
-            base->flags.clearing = true;
+            base->clearing.store(true);
           }
 
           ~temporarily_set_clearing()
           {
-            base->flags.clearing = false;
+            base->clearing.store(false);
           }
 
         private:
@@ -67,7 +149,10 @@ namespace boost {
 
         friend class temporarily_set_clearing;
 
-        signal_base_impl(const compare_type&, const any&);
+        // The group comparison object is only used to create the slot
+        // container
+        signal_base_impl(const void* group_compare, const any& combiner,
+                         slot_map_factory, signal_lock_factory);
         ~signal_base_impl();
 
         // Disconnect all slots connected to this signal
@@ -82,47 +167,93 @@ namespace boost {
         // Disconnect all slots in the given group
         void disconnect(const stored_group&);
 
+        // Disconnect each of the given connections. Connections to the
+        // same signal are disconnected together, so that the signal can
+        // remove their slots in one pass; the vector is reordered.
+        static void disconnect_each(std::vector<connection>&);
+
         // We're being notified that a slot has disconnected
         static void slot_disconnected(void* obj, void* data);
 
-        connection connect_slot(const any& slot,
+        // Connect the slot function pointed to by slot, which the slot
+        // container copies
+        connection connect_slot(const void* slot,
                                 const stored_group& name,
                                 shared_ptr<slot_base::data_t> data,
                                 connect_position at);
 
+        // Connect each of the slots of the sequence to the same group,
+        // holding the lock throughout, and append their connections to
+        // the given vector. Slots whose bound objects are gone get a
+        // disconnected connection. If an exception is thrown, none of
+        // the slots is left connected.
+        void connect_slots(const stored_group& name, connect_position at,
+                           slot_sequence& slots,
+                           std::vector<connection>& out);
+
       private:
         // Remove all of the slots that have been marked "disconnected"
         void remove_disconnected_slots() const;
 
+        // Orders connections by the signal they notify
+        static bool signal_order(const connection&, const connection&);
+
+        // Disconnect the given connections, which belong to this signal,
+        // and remove their slots together
+        void disconnect_batch(std::vector<connection>::iterator first,
+                              std::vector<connection>::iterator last);
+
       public:
-        // Our call depth when invoking slots (> 1 when we have a loop)
+        // Our call depth when invoking slots (> 1 when we have a loop, or
+        // when several threads call a signal that has a lock)
         mutable int call_depth;
 
+        // The number of connected slots. Every slot that is connected
+        // through connect_slot is counted until slot_disconnected is
+        // notified of its disconnection, whether it is disconnected on its
+        // own, with its group, or by disconnect_all_slots. Slots may be
+        // connected and disconnected from several threads at once when the
+        // slot storage allows it, so the count is atomic.
+        boost::detail::atomic_count connected_slots;
+
+        // The number of disconnect_batch calls under way. While it is not
+        // zero, disconnected slots are left in place for the batch to
+        // remove. It is atomic because slot storage that synchronizes
+        // itself has no signal lock.
+        boost::detail::atomic_count batch_depth;
+
         struct {
           // True if some slots have disconnected, but we were not able to
           // remove them from the list of slots because there are valid
           // iterators into the slot list
           mutable bool delayed_disconnect:1;
-
-          // True if we are disconnecting all disconnected slots
-          bool clearing:1;
         } flags;
 
+        // True if we are disconnecting all slots. Slot storage that
+        // synchronizes itself has no signal lock, and lets other threads
+        // disconnect slots meanwhile, so the flag is atomic.
+        boost::atomic<bool> clearing;
+
+        // Guards the slots and the bookkeeping above against other
+        // threads: it is held while slots are connected and disconnected
+        // and while the call depth changes, and shared for each step
+        // through the slots while they are called, but never while a slot
+        // runs. Null if the signal has no lock. Slot storage that
+        // synchronizes itself needs none.
+        scoped_ptr<signal_lock> lock_;
+
         // Slots
-        mutable named_slot_map slots_;
+        scoped_ptr<slot_map_base> slots_;
         any combiner_;
-
-        // Types
-        typedef named_slot_map::iterator iterator;
       };
 
       class BOOST_SIGNALS_DECL signal_base : public noncopyable {
       public:
-        typedef signal_base_impl::compare_type compare_type;
-
         friend class call_notification;
 
-        signal_base(const compare_type& comp, const any& combiner);
+        signal_base(const void* group_compare, const any& combiner,
+                    slot_map_factory create_slots,
+                    signal_lock_factory create_lock);
         ~signal_base();
 
       public:
@@ -136,7 +267,7 @@ namespace boost {
         std::size_t num_slots() const { return impl->num_slots(); }
 
       protected:
-        connection connect_slot(const any& slot,
+        connection connect_slot(const void* slot,
                                 const stored_group& name,
                                 shared_ptr<slot_base::data_t> data,
                                 connect_position at)
@@ -144,10 +275,115 @@ namespace boost {
           return impl->connect_slot(slot, name, data, at);
         }
 
-        typedef named_slot_map::iterator iterator;
+        // The slot container, which the signalN templates iterate directly
+        template<typename SlotMap>
+        SlotMap& slot_map() const
+        { return static_cast<SlotMap&>(*impl->slots_); }
 
         shared_ptr<signal_base_impl> impl;
       };
+
+      // An iterator through the slots of a signal that has a lock, which
+      // holds the lock shared while it steps through the slot container,
+      // as other threads may be connecting slots meanwhile. The slot it
+      // refers to stays in place once the lock is released, because slots
+      // are neither moved nor erased while they are being called.
+      template<typename Iterator>
+      class locked_slot_iterator :
+        public iterator_facade<locked_slot_iterator<Iterator>,
+                               typename iterator_value<Iterator>::type,
+                               forward_traversal_tag>
+      {
+      public:
+        locked_slot_iterator() : lock(0) {}
+        locked_slot_iterator(const Iterator& i, signal_lock* l)
+          : iter(i), lock(l)
+        {
+        }
+
+        typename iterator_value<Iterator>::type& dereference() const
+        {
+          lock->lock_shared();
+          typename iterator_value<Iterator>::type& slot = *iter;
+          lock->unlock_shared();
+          return slot;
+        }
+
+        void increment()
+        {
+          lock->lock_shared();
+          ++iter;
+          lock->unlock_shared();
+        }
+
+        // Comparing slot container iterators does not look into the
+        // container
+        bool equal(const locked_slot_iterator& other) const
+        {
+          return iter == other.iter;
+        }
+
+      private:
+        Iterator iter;
+        signal_lock* lock;
+      };
+
+      // Keeps the slots of a signal in place while they are being called,
+      // and gives access to them. Locked is true if the signal has a lock.
+      // Slot containers that have another way of keeping their slots in
+      // place specialize this.
+      template<typename SlotMap, bool Locked = false>
+      class slot_call_scope {
+      public:
+        typedef typename SlotMap::iterator iterator;
+
+        slot_call_scope(const shared_ptr<signal_base_impl>& impl,
+                        SlotMap& s)
+          : notification(impl), slots(s)
+        {
+        }
+
+        iterator begin() const { return slots.begin(); }
+        iterator end() const { return slots.end(); }
+
+      private:
+        call_notification notification;
+        SlotMap& slots;
+      };
+
+      template<typename SlotMap>
+      class slot_call_scope<SlotMap, true> {
+      public:
+        typedef locked_slot_iterator<typename SlotMap::iterator> iterator;
+
+        slot_call_scope(const shared_ptr<signal_base_impl>& impl,
+                        SlotMap& s)
+          : notification(impl), slots(s)
+        {
+        }
+
+        iterator begin() const
+        {
+          signal_lock* lock = notification.impl->lock_.get();
+          lock->lock_shared();
+          iterator result(slots.begin(), lock);
+          lock->unlock_shared();
+          return result;
+        }
+
+        iterator end() const
+        {
+          signal_lock* lock = notification.impl->lock_.get();
+          lock->lock_shared();
+          iterator result(slots.end(), lock);
+          lock->unlock_shared();
+          return result;
+        }
+
+      private:
+        call_notification notification;
+        SlotMap& slots;
+      };
     } // end namespace detail
   } // end namespace BOOST_SIGNALS_NAMESPACE
 } // end namespace boost
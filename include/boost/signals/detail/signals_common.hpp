@@ -16,6 +16,7 @@
 
 #include <boost/type_traits/conversion_traits.hpp>
 #include <boost/ref.hpp>
+#include <boost/container/allocator_traits.hpp>
 #include <boost/signals/detail/config.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -129,6 +130,14 @@ namespace boost {
                             signal_or_value>::type type;
       };
 
+      // The allocator for objects of type T that corresponds to the
+      // Allocator parameter of a signal
+      template<typename Allocator, typename T>
+      struct rebind_allocator {
+        typedef typename container::allocator_traits<Allocator>::template
+                  portable_rebind_alloc<T>::type type;
+      };
+
       // Forward declaration needed in lots of places
       class signal_base_impl;
       class bound_objects_visitor;
@@ -10,12 +10,15 @@
 #ifndef BOOST_SIGNALS_SLOT_CALL_ITERATOR
 #define BOOST_SIGNALS_SLOT_CALL_ITERATOR
 
+#include <algorithm>
 #include <memory>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/smart_ptr.hpp>
 #include <boost/signals/detail/config.hpp>
 #include <boost/signals/connection.hpp>
 #include <boost/optional.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/signals/detail/signals_common.hpp>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -29,14 +32,19 @@ namespace boost {
       //   - skips over disconnected slots in the underlying list
       //   - calls the connected slots when dereferenced
       //   - caches the result of calling the slots
-      template<typename Function, typename Iterator>
+      // Each increment moves straight to the next callable slot, so
+      // comparing iterators does not need to search the list again. The
+      // result of a slot call is cached within the iterator itself.
+      template<typename Function, typename Iterator,
+               bool IsVoid = (is_same<typename Function::result_type,
+                                      unusable>::value)>
       class slot_call_iterator
-        : public iterator_facade<slot_call_iterator<Function, Iterator>,
+        : public iterator_facade<slot_call_iterator<Function, Iterator, IsVoid>,
                                  typename Function::result_type,
                                  single_pass_traversal_tag,
                                  typename Function::result_type const&>
       {
-        typedef iterator_facade<slot_call_iterator<Function, Iterator>,
+        typedef iterator_facade<slot_call_iterator<Function, Iterator, IsVoid>,
                                 typename Function::result_type,
                                 single_pass_traversal_tag,
                                 typename Function::result_type const&>
@@ -47,42 +55,92 @@ namespace boost {
         friend class iterator_core_access;
 
       public:
-        slot_call_iterator(Iterator iter_in, Iterator end_in, Function func,
-                           optional<result_type> &c)
-          : iter(iter_in), end(end_in), f(func), cache(&c)
+        slot_call_iterator(Iterator iter_in, Iterator end_in, Function func)
+          : iter(std::find_if(iter_in, end_in, is_callable())), end(end_in),
+            f(func), cache()
+        {
+        }
+
+        typename inherited::reference
+        dereference() const
+        {
+          if (!cache.is_initialized()) {
+            cache.reset(f(*iter));
+          }
+
+          return cache.get();
+        }
+
+        void increment()
+        {
+          iter = std::find_if(++iter, end, is_callable());
+          cache.reset();
+        }
+
+        bool equal(const slot_call_iterator& other) const
+        {
+          return iter == other.iter;
+        }
+
+      private:
+        Iterator iter;
+        Iterator end;
+        Function f;
+        mutable optional<result_type> cache;
+      };
+
+      // Slots returning void have no result to cache: the iterator only
+      // remembers whether the current slot has been called.
+      template<typename Function, typename Iterator>
+      class slot_call_iterator<Function, Iterator, true>
+        : public iterator_facade<slot_call_iterator<Function, Iterator, true>,
+                                 unusable,
+                                 single_pass_traversal_tag,
+                                 unusable const&>
+      {
+        typedef iterator_facade<slot_call_iterator<Function, Iterator, true>,
+                                unusable,
+                                single_pass_traversal_tag,
+                                unusable const&>
+          inherited;
+
+        friend class iterator_core_access;
+
+      public:
+        slot_call_iterator(Iterator iter_in, Iterator end_in, Function func)
+          : iter(std::find_if(iter_in, end_in, is_callable())), end(end_in),
+            f(func), called(false)
         {
-          iter = std::find_if(iter, end, is_callable());
         }
 
         typename inherited::reference
         dereference() const
         {
-          if (!cache->is_initialized()) {
-            cache->reset(f(*iter));
+          if (!called) {
+            f.call(*iter);
+            called = true;
           }
 
-          return cache->get();
+          return result;
         }
 
         void increment()
         {
           iter = std::find_if(++iter, end, is_callable());
-          cache->reset();
+          called = false;
         }
 
         bool equal(const slot_call_iterator& other) const
         {
-          iter = std::find_if(iter, end, is_callable());
-          other.iter = std::find_if(other.iter, other.end,
-                                    is_callable());
           return iter == other.iter;
         }
 
       private:
-        mutable Iterator iter;
+        Iterator iter;
         Iterator end;
         Function f;
-        optional<result_type>* cache;
+        mutable bool called;
+        unusable result;
       };
     } // end namespace detail
   } // end namespace BOOST_SIGNALS_NAMESPACE
@@ -0,0 +1,377 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_SNAPSHOT_SLOT_MAP_HPP
+#define BOOST_SIGNALS_SNAPSHOT_SLOT_MAP_HPP
+
+#include <boost/signals/detail/config.hpp>
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/detail/named_slot_map.hpp>
+#include <boost/signals/detail/signal_base.hpp>
+#include <boost/signals/connection.hpp>
+#include <boost/smart_ptr/detail/lightweight_mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost { namespace BOOST_SIGNALS_NAMESPACE { namespace detail {
+
+// A slot in a snapshot: its group, its connection and its slot function.
+// Snapshots share slot functions, so that publishing a new snapshot does
+// not copy them.
+template<typename SlotFunction>
+struct snapshot_slot {
+  snapshot_slot(const stored_group& g, const connection& c,
+                const shared_ptr<SlotFunction>& f)
+    : group(g), first(c), second(f)
+  {
+  }
+
+  stored_group group;
+  connection first;
+  shared_ptr<SlotFunction> second;
+};
+
+template<typename SlotFunction>
+inline SlotFunction& stored_function(const snapshot_slot<SlotFunction>& slot)
+{
+  return *slot.second;
+}
+
+// Orders slots by group, using the given comparison of stored groups
+template<typename Compare>
+class snapshot_group_less {
+public:
+  snapshot_group_less(const Compare& c) : compare(c) { }
+
+  template<typename Slot>
+  bool operator()(const Slot& slot, const stored_group& name) const
+  { return compare(slot.group, name); }
+
+  template<typename Slot>
+  bool operator()(const stored_group& name, const Slot& slot) const
+  { return compare(name, slot.group); }
+
+private:
+  const Compare& compare;
+};
+
+// Slot container for signals that are used from several threads. The
+// slots, in calling order, form an immutable snapshot. Calling the signal
+// only takes a reference to the current snapshot, so any number of
+// threads may call it at once; connecting and disconnecting slots copy
+// the snapshot and publish the copy under a writer lock. The reference
+// is taken with boost::atomic_load, which briefly holds one of the
+// spinlocks that Boost.SmartPtr keeps for atomic shared_ptr access, so
+// calls are short of lock-free. A slot that is disconnected while a call
+// is under way is skipped by that call, but a slot connected meanwhile is
+// not called until the next one.
+//
+// Snapshots only hold non-controlling copies of the connections, so
+// releasing an old snapshot never disconnects anything; the map
+// disconnects its slots itself when it is cleared or destroyed. The
+// position data of a slot is the address of its basic_connection.
+// Snapshots, slot functions and group names are allocated with the
+// allocator of the signal. Groups are ordered by calling the group
+// comparison of the signal directly.
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+class snapshot_slot_map : public slot_map_base
+{
+  typedef snapshot_slot<SlotFunction> slot_type;
+  typedef boost::detail::lightweight_mutex mutex_type;
+  typedef group_bridge_compare<GroupCompare, Group> compare_type;
+  typedef snapshot_group_less<compare_type> group_less;
+
+public:
+  typedef std::vector<slot_type,
+                      typename rebind_allocator<Allocator, slot_type>::type>
+    snapshot_type;
+  typedef typename snapshot_type::const_iterator iterator;
+  typedef GroupCompare group_compare_type;
+
+  snapshot_slot_map(const GroupCompare& c)
+    : compare(c), current(new_snapshot())
+  {
+  }
+
+  ~snapshot_slot_map() { clear(); }
+
+  // The slots as they are now. They will not change, however the signal
+  // is modified later.
+  shared_ptr<const snapshot_type> snapshot() const
+  { return boost::atomic_load(&current); }
+
+  void clear();
+  void* insert_slot(const stored_group& name, const connection& con,
+                    const void* slot, connect_position at);
+  void insert_slots(const stored_group& name, connect_position at,
+                    slot_source& source);
+  void erase_slot(void* position);
+  void release_position(void*) { }
+  void group_connections(const stored_group& name,
+                         std::vector<connection>& out);
+  void connections(std::vector<connection>& out);
+  void remove_disconnected_slots();
+
+  // Erasing a slot copies the whole snapshot, so removing several slots
+  // at once is always cheaper
+  bool prefer_batch_erase(std::size_t count, std::size_t) const
+  { return count > 1; }
+
+private:
+  // The group of a slot inserted with the given name and position. The
+  // name may only be borrowed, so the slot keeps its own copy.
+  static stored_group slot_group(const stored_group& name,
+                                 connect_position at)
+  {
+    if (name.empty())
+      return stored_group(at == at_front? stored_group::sk_front
+                                        : stored_group::sk_back);
+    return name.owned<Group>(Allocator());
+  }
+
+  static shared_ptr<snapshot_type> new_snapshot()
+  { return boost::allocate_shared<snapshot_type>(Allocator()); }
+
+  // Replace the current snapshot with the given one, which the caller
+  // gets back in exchange. Must be called with the writer lock held.
+  void publish(shared_ptr<const snapshot_type>& next)
+  {
+    shared_ptr<const snapshot_type> previous = current;
+    boost::atomic_store(&current, next);
+    next.swap(previous);
+  }
+
+  compare_type compare;
+
+  // Serializes the publication of snapshots
+  mutex_type writer;
+
+  shared_ptr<const snapshot_type> current;
+};
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>::clear()
+{
+  // Released after the lock, since destroying slot functions may reenter
+  // the map
+  shared_ptr<const snapshot_type> slots = new_snapshot();
+  {
+    mutex_type::scoped_lock lock(writer);
+    publish(slots);
+  }
+
+  for (iterator i = slots->begin(); i != slots->end(); ++i)
+    i->first.disconnect();
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void*
+snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>::insert_slot(
+  const stored_group& name, const connection& con, const void* slot,
+  connect_position at)
+{
+  stored_group group = slot_group(name, at);
+
+  shared_ptr<SlotFunction> f =
+    boost::allocate_shared<SlotFunction>(
+      Allocator(), *static_cast<const SlotFunction*>(slot));
+
+  shared_ptr<const snapshot_type> slots;
+  {
+    mutex_type::scoped_lock lock(writer);
+
+    const snapshot_type& old_slots = *current;
+    iterator pos = (at == at_front)?
+      std::lower_bound(old_slots.begin(), old_slots.end(), group,
+                       group_less(compare)) :
+      std::upper_bound(old_slots.begin(), old_slots.end(), group,
+                       group_less(compare));
+
+    shared_ptr<snapshot_type> new_slots = new_snapshot();
+    new_slots->reserve(old_slots.size() + 1);
+    new_slots->insert(new_slots->end(), old_slots.begin(), pos);
+    new_slots->push_back(slot_type(group, con, f));
+    new_slots->insert(new_slots->end(), pos, old_slots.end());
+
+    slots = new_slots;
+    publish(slots);
+  }
+
+  return con.get_connection().get();
+}
+
+// Publishes all of the slots in a single snapshot
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void
+snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>::insert_slots(
+  const stored_group& name, connect_position at, slot_source& source)
+{
+  stored_group group = slot_group(name, at);
+
+  snapshot_type inserted;
+  const connection* con;
+  const void* slot;
+  while (source.next(con, slot)) {
+    inserted.push_back(
+      slot_type(group, *con,
+                boost::allocate_shared<SlotFunction>(
+                  Allocator(), *static_cast<const SlotFunction*>(slot))));
+    source.inserted(con->get_connection().get());
+  }
+  if (inserted.empty())
+    return;
+
+  // Each slot inserted at the front goes before the ones inserted earlier
+  if (at == at_front)
+    std::reverse(inserted.begin(), inserted.end());
+
+  shared_ptr<const snapshot_type> slots;
+  {
+    mutex_type::scoped_lock lock(writer);
+
+    const snapshot_type& old_slots = *current;
+    iterator pos = (at == at_front)?
+      std::lower_bound(old_slots.begin(), old_slots.end(), group,
+                       group_less(compare)) :
+      std::upper_bound(old_slots.begin(), old_slots.end(), group,
+                       group_less(compare));
+
+    shared_ptr<snapshot_type> new_slots = new_snapshot();
+    new_slots->reserve(old_slots.size() + inserted.size());
+    new_slots->insert(new_slots->end(), old_slots.begin(), pos);
+    for (iterator i = inserted.begin(); i != inserted.end(); ++i) {
+      // Another thread may have disconnected the slot already
+      if (i->first.connected())
+        new_slots->push_back(*i);
+    }
+    new_slots->insert(new_slots->end(), pos, old_slots.end());
+
+    slots = new_slots;
+    publish(slots);
+  }
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void
+snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>::erase_slot(
+  void* position)
+{
+  shared_ptr<const snapshot_type> slots;
+  {
+    mutex_type::scoped_lock lock(writer);
+
+    const snapshot_type& old_slots = *current;
+    shared_ptr<snapshot_type> new_slots = new_snapshot();
+    new_slots->reserve(old_slots.size());
+    for (iterator i = old_slots.begin(); i != old_slots.end(); ++i) {
+      if (i->first.get_connection().get() != position)
+        new_slots->push_back(*i);
+    }
+
+    slots = new_slots;
+    publish(slots);
+  }
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void
+snapshot_slot_map<SlotFunction, Group, GroupCompare,
+                  Allocator>::group_connections(
+  const stored_group& name, std::vector<connection>& out)
+{
+  shared_ptr<const snapshot_type> slots = snapshot();
+  std::pair<iterator, iterator> group =
+    std::equal_range(slots->begin(), slots->end(), name,
+                     group_less(compare));
+
+  for (iterator i = group.first; i != group.second; ++i)
+    out.push_back(i->first);
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void
+snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>::connections(
+  std::vector<connection>& out)
+{
+  shared_ptr<const snapshot_type> slots = snapshot();
+  for (iterator i = slots->begin(); i != slots->end(); ++i)
+    out.push_back(i->first);
+}
+
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+void snapshot_slot_map<SlotFunction, Group, GroupCompare,
+                       Allocator>::remove_disconnected_slots()
+{
+  shared_ptr<const snapshot_type> slots;
+  {
+    mutex_type::scoped_lock lock(writer);
+
+    const snapshot_type& old_slots = *current;
+    shared_ptr<snapshot_type> new_slots = new_snapshot();
+    for (iterator i = old_slots.begin(); i != old_slots.end(); ++i) {
+      if (i->first.connected())
+        new_slots->push_back(*i);
+    }
+
+    slots = new_slots;
+    publish(slots);
+  }
+}
+
+// Calling a signal with snapshot slot storage leaves the call depth alone:
+// the call walks the snapshot that was current when it started, which
+// nothing else modifies.
+template<typename SlotFunction, typename Group, typename GroupCompare,
+         typename Allocator>
+class slot_call_scope<snapshot_slot_map<SlotFunction, Group, GroupCompare,
+                                        Allocator>, false> {
+  typedef snapshot_slot_map<SlotFunction, Group, GroupCompare, Allocator>
+    slot_map_type;
+
+public:
+  typedef typename slot_map_type::iterator iterator;
+
+  slot_call_scope(const shared_ptr<signal_base_impl>& i,
+                  const slot_map_type& slots)
+    : impl(i), snapshot(slots.snapshot())
+  {
+  }
+
+  iterator begin() const { return snapshot->begin(); }
+  iterator end() const { return snapshot->end(); }
+
+private:
+  // Keeps the signal alive while the slots are being called
+  shared_ptr<signal_base_impl> impl;
+
+  shared_ptr<const typename slot_map_type::snapshot_type> snapshot;
+};
+
+} } }
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_SNAPSHOT_SLOT_MAP_HPP
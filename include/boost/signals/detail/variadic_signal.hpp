@@ -0,0 +1,318 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_VARIADIC_SIGNAL_HPP
+#define BOOST_SIGNALS_VARIADIC_SIGNAL_HPP
+
+#include <boost/signals/detail/config.hpp>
+#include <boost/signals/detail/basic_signal.hpp>
+#include <boost/last_value.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // The result type of a function type
+      template<typename Signature> struct signature_result;
+
+      template<typename R, typename... Args>
+      struct signature_result<R (Args...)> {
+        typedef R type;
+      };
+
+      // The positions of the arguments of a call
+      template<std::size_t... I> struct index_list { };
+
+      template<std::size_t N, std::size_t... I>
+      struct make_index_list : make_index_list<N - 1, N - 1, I...> { };
+
+      template<std::size_t... I>
+      struct make_index_list<0, I...> {
+        typedef index_list<I...> type;
+      };
+
+      // How an argument of a signal is passed on to each slot. Arguments
+      // declared as rvalue references are passed on as rvalues; all
+      // others are passed as lvalues that refer to the argument of the
+      // signal, so that no slot sees an argument that an earlier slot
+      // has moved from.
+      template<typename T>
+      struct forwarded_argument {
+        typedef T& type;
+      };
+
+      template<typename T>
+      struct forwarded_argument<T&&> {
+        typedef T&& type;
+      };
+
+      // The argN_type typedefs of the first ten arguments
+      template<typename... Args> struct arg10_types { };
+      template<typename T, typename... Args>
+      struct arg10_types<T, Args...> { typedef T arg10_type; };
+
+      template<typename... Args> struct arg9_types { };
+      template<typename T, typename... Args>
+      struct arg9_types<T, Args...> : arg10_types<Args...>
+      { typedef T arg9_type; };
+
+      template<typename... Args> struct arg8_types { };
+      template<typename T, typename... Args>
+      struct arg8_types<T, Args...> : arg9_types<Args...>
+      { typedef T arg8_type; };
+
+      template<typename... Args> struct arg7_types { };
+      template<typename T, typename... Args>
+      struct arg7_types<T, Args...> : arg8_types<Args...>
+      { typedef T arg7_type; };
+
+      template<typename... Args> struct arg6_types { };
+      template<typename T, typename... Args>
+      struct arg6_types<T, Args...> : arg7_types<Args...>
+      { typedef T arg6_type; };
+
+      template<typename... Args> struct arg5_types { };
+      template<typename T, typename... Args>
+      struct arg5_types<T, Args...> : arg6_types<Args...>
+      { typedef T arg5_type; };
+
+      template<typename... Args> struct arg4_types { };
+      template<typename T, typename... Args>
+      struct arg4_types<T, Args...> : arg5_types<Args...>
+      { typedef T arg4_type; };
+
+      template<typename... Args> struct arg3_types { };
+      template<typename T, typename... Args>
+      struct arg3_types<T, Args...> : arg4_types<Args...>
+      { typedef T arg3_type; };
+
+      template<typename... Args> struct arg2_types { };
+      template<typename T, typename... Args>
+      struct arg2_types<T, Args...> : arg3_types<Args...>
+      { typedef T arg2_type; };
+
+      template<typename... Args> struct arg1_types { };
+      template<typename T, typename... Args>
+      struct arg1_types<T, Args...> : arg2_types<Args...>
+      { typedef T arg1_type; };
+
+      // The argument typedefs of a signal: argN_type, and argument_type
+      // or first_argument_type and second_argument_type for signals of
+      // one or two arguments
+      template<typename... Args>
+      struct argument_types : arg1_types<Args...> { };
+
+      template<typename T1>
+      struct argument_types<T1> : arg1_types<T1> {
+        typedef T1 argument_type;
+      };
+
+      template<typename T1, typename T2>
+      struct argument_types<T1, T2> : arg1_types<T1, T2> {
+        typedef T1 first_argument_type;
+        typedef T2 second_argument_type;
+      };
+
+      // Function object that calls the slot given to it, passing along the
+      // arguments of the signal call, to which it refers
+      template<typename R, typename F, typename... Args>
+      struct call_bound_variadic {
+        typedef std::tuple<Args&...>* args_type;
+
+        typedef R result_type;
+
+        call_bound_variadic() {}
+        call_bound_variadic(args_type a) : args(a) {}
+
+        template<typename Slot>
+        R operator()(const Slot& slot) const
+        {
+          return invoke(stored_function<F>(slot),
+                        typename make_index_list<sizeof...(Args)>::type());
+        }
+
+      private:
+        template<std::size_t... I>
+        R invoke(F& target, index_list<I...>) const
+        {
+          return target(static_cast<typename forwarded_argument<Args>::type>(
+                          std::get<I>(*args))...);
+        }
+
+        args_type args;
+      };
+
+      template<typename F, typename... Args>
+      struct call_bound_variadic<void, F, Args...> {
+        typedef std::tuple<Args&...>* args_type;
+
+        typedef unusable result_type;
+
+        call_bound_variadic(args_type a) : args(a) {}
+
+        template<typename Slot>
+        unusable operator()(const Slot& slot) const
+        {
+          call(slot);
+          return unusable();
+        }
+
+        // Used by the slot call iterator, which has no result to cache
+        template<typename Slot>
+        void call(const Slot& slot) const
+        {
+          invoke(stored_function<F>(slot),
+                 typename make_index_list<sizeof...(Args)>::type());
+        }
+
+      private:
+        template<std::size_t... I>
+        void invoke(F& target, index_list<I...>) const
+        {
+          target(static_cast<typename forwarded_argument<Args>::type>(
+                   std::get<I>(*args))...);
+        }
+
+        args_type args;
+      };
+
+      // Calls a member function of an object, for connect_member
+      template<typename R, typename T, typename MemberFunction>
+      struct member_slot {
+        member_slot(T* o, MemberFunction m) : object(o), method(m) {}
+
+        template<typename... A>
+        R operator()(A&&... args) const
+        {
+          return static_cast<R>((object->*method)(std::forward<A>(args)...));
+        }
+
+        T* object;
+        MemberFunction method;
+      };
+
+      template<
+        typename Signature,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      class variadic_signal;
+
+      // A signal with any number of arguments, which implements
+      // boost::signal and the signalN class templates. Calling it does not
+      // copy the arguments: the slots receive references to the arguments
+      // of the call.
+      template<
+        typename R,
+        typename... Args,
+        typename Combiner,
+        typename Group,
+        typename GroupCompare,
+        typename SlotFunction,
+        typename SlotStorage,
+        typename LockPolicy,
+        typename Allocator
+      >
+      class variadic_signal<R (Args...), Combiner, Group, GroupCompare,
+                            SlotFunction, SlotStorage, LockPolicy,
+                            Allocator> :
+        public basic_signal<R, Combiner, Group, GroupCompare, SlotFunction,
+                            SlotStorage, LockPolicy, Allocator>,
+        public argument_types<Args...>
+      {
+        typedef basic_signal<R, Combiner, Group, GroupCompare, SlotFunction,
+                             SlotStorage, LockPolicy, Allocator>
+          base_type;
+
+      public:
+        typedef typename base_type::slot_function_type slot_function_type;
+        typedef typename base_type::result_type result_type;
+        typedef typename base_type::slot_type slot_type;
+        typedef typename base_type::group_type group_type;
+
+      private:
+        // The function object passed to the slot call iterator that will
+        // call the underlying slot function with the arguments
+        typedef call_bound_variadic<R, slot_function_type, Args...>
+          call_bound_slot;
+
+        // The slot of connect_member, which calls the member function of
+        // obj
+        template<typename T, typename MemberFunction>
+        static slot_type make_member_slot(T* obj, MemberFunction method)
+        {
+          return slot_type(member_slot<R, T, MemberFunction>(obj, method),
+                           obj);
+        }
+
+      public:
+        typedef BOOST_SIGNALS_NAMESPACE::detail::slot_call_iterator<
+                  call_bound_slot, typename base_type::iterator>
+          slot_call_iterator;
+
+        explicit
+        variadic_signal(const Combiner& c = Combiner(),
+                        const GroupCompare& comp = GroupCompare()) :
+          base_type(c, comp)
+        {
+        }
+
+
+        // Connect a member function of obj, without binding it; the slot
+        // is disconnected when obj is destroyed if obj is trackable
+        template<typename T, typename MemberFunction>
+        connection connect_member(T* obj, MemberFunction method,
+                                  connect_position at = at_back)
+        {
+          return this->connect(make_member_slot(obj, method), at);
+        }
+
+        template<typename T, typename MemberFunction>
+        connection connect_member(const group_type& group, T* obj,
+                                  MemberFunction method,
+                                  connect_position at = at_back)
+        {
+          return this->connect(group, make_member_slot(obj, method), at);
+        }
+
+        // Emit the signal
+        result_type operator()(Args... args)
+        {
+          std::tuple<Args&...> bound(args...);
+          return this->call_slots(call_bound_slot(&bound));
+        }
+
+        result_type operator()(Args... args) const
+        {
+          std::tuple<Args&...> bound(args...);
+          return this->call_slots(call_bound_slot(&bound));
+        }
+      };
+    } // end namespace detail
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_VARIADIC_SIGNAL_HPP
@@ -0,0 +1,328 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_INLINE_FUNCTION_HEADER
+#define BOOST_SIGNALS_INLINE_FUNCTION_HEADER
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+    || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#  error "boost/signals/inline_function.hpp requires variadic templates"
+#endif
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/function/function_base.hpp>
+#include <boost/function_equal.hpp>
+#include <boost/ref.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// The default size of the buffer in which an inline_function keeps its
+// function object: enough for a member function pointer bound to an
+// object and an argument or two
+#ifndef BOOST_SIGNALS_INLINE_FUNCTION_SIZE
+#  define BOOST_SIGNALS_INLINE_FUNCTION_SIZE (4 * sizeof(void*))
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // Copies, moves and destroys the function object held by an
+      // inline_function. There is one per type of function object, so
+      // its address also identifies that type.
+      struct inline_function_manager {
+        void (*copy)(const void* from, void* to);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* buffer);
+      };
+
+      // Function objects that fit in the buffer are kept there;
+      // others are allocated, and the buffer holds a pointer to them
+      template<typename F, bool Inline>
+      struct inline_function_ops {
+        static F& get(void* buffer) { return *static_cast<F*>(buffer); }
+
+        static void create(const F& f, void* to) { new (to) F(f); }
+
+        static void copy(const void* from, void* to)
+        { new (to) F(*static_cast<const F*>(from)); }
+
+        static void move(void* from, void* to)
+        {
+          new (to) F(std::move(get(from)));
+          get(from).~F();
+        }
+
+        static void destroy(void* buffer) { get(buffer).~F(); }
+
+        static const inline_function_manager manager;
+      };
+
+      template<typename F>
+      struct inline_function_ops<F, false> {
+        static F& get(void* buffer) { return **static_cast<F**>(buffer); }
+
+        static void create(const F& f, void* to)
+        { *static_cast<F**>(to) = new F(f); }
+
+        static void copy(const void* from, void* to)
+        { *static_cast<F**>(to) = new F(**static_cast<F* const*>(from)); }
+
+        static void move(void* from, void* to)
+        { *static_cast<F**>(to) = *static_cast<F**>(from); }
+
+        static void destroy(void* buffer) { delete &get(buffer); }
+
+        static const inline_function_manager manager;
+      };
+
+      template<typename F, bool Inline>
+      const inline_function_manager
+      inline_function_ops<F, Inline>::manager = {
+        &inline_function_ops<F, Inline>::copy,
+        &inline_function_ops<F, Inline>::move,
+        &inline_function_ops<F, Inline>::destroy
+      };
+
+      template<typename F>
+      const inline_function_manager
+      inline_function_ops<F, false>::manager = {
+        &inline_function_ops<F, false>::copy,
+        &inline_function_ops<F, false>::move,
+        &inline_function_ops<F, false>::destroy
+      };
+    } // end namespace detail
+
+    template<typename Signature,
+             std::size_t BufferSize = BOOST_SIGNALS_INLINE_FUNCTION_SIZE>
+    class inline_function;
+
+    template<typename T>
+    struct is_inline_function : std::false_type { };
+
+    template<typename Signature, std::size_t BufferSize>
+    struct is_inline_function<inline_function<Signature, BufferSize> > :
+      std::true_type { };
+
+    // A slot function that keeps function objects of up to BufferSize
+    // bytes in place, without allocating, and calls them through a
+    // single function pointer. It may be used as the SlotFunction of a
+    // signal instead of boost::function.
+    template<typename R, typename... Args, std::size_t BufferSize>
+    class inline_function<R (Args...), BufferSize> {
+      typedef R (*invoker_type)(void*, Args...);
+
+      // Whether a function object of type F is kept in the buffer
+      template<typename F>
+      struct fits : std::integral_constant<bool,
+        (sizeof(F) <= BufferSize
+         && std::alignment_of<F>::value
+              <= std::alignment_of<std::max_align_t>::value
+         && std::is_nothrow_move_constructible<F>::value)> { };
+
+      template<typename F>
+      struct ops : detail::inline_function_ops<F, fits<F>::value> { };
+
+    public:
+      typedef R result_type;
+
+      BOOST_STATIC_CONSTANT(std::size_t, buffer_size = BufferSize);
+
+      inline_function() BOOST_NOEXCEPT :
+        invoker(&invoke_empty), manager(0)
+      {
+      }
+
+      template<typename F>
+      inline_function(const F& f,
+                      typename std::enable_if<
+                        !is_inline_function<F>::value, int>::type = 0) :
+        invoker(0), manager(0)
+      {
+        assign(f);
+      }
+
+      inline_function(const inline_function& other) :
+        invoker(other.invoker), manager(other.manager)
+      {
+        if (manager)
+          manager->copy(&other.buffer, &buffer);
+      }
+
+      inline_function(inline_function&& other) BOOST_NOEXCEPT :
+        invoker(other.invoker), manager(other.manager)
+      {
+        if (manager) {
+          manager->move(&other.buffer, &buffer);
+          other.invoker = &invoke_empty;
+          other.manager = 0;
+        }
+      }
+
+      ~inline_function() { clear(); }
+
+      inline_function& operator=(const inline_function& other)
+      {
+        inline_function(other).swap(*this);
+        return *this;
+      }
+
+      inline_function& operator=(inline_function&& other) BOOST_NOEXCEPT
+      {
+        inline_function(std::move(other)).swap(*this);
+        return *this;
+      }
+
+      void swap(inline_function& other) BOOST_NOEXCEPT
+      {
+        if (&other == this)
+          return;
+
+        inline_function temp(std::move(other));
+        other.take(*this);
+        take(temp);
+      }
+
+      void clear() BOOST_NOEXCEPT
+      {
+        if (manager) {
+          manager->destroy(&buffer);
+          invoker = &invoke_empty;
+          manager = 0;
+        }
+      }
+
+      bool empty() const { return manager == 0; }
+
+      explicit operator bool() const { return !empty(); }
+
+      // The function object, if it is of type F
+      template<typename F>
+      F* target()
+      {
+        if (manager != &ops<F>::manager)
+          return 0;
+        return &ops<F>::get(&buffer);
+      }
+
+      template<typename F>
+      const F* target() const
+      {
+        return const_cast<inline_function*>(this)->template target<F>();
+      }
+
+      // Whether the function object is equal to f, as
+      // boost::function::contains, which makes disconnecting a slot by
+      // its function object work
+      template<typename F>
+      bool contains(const F& f) const
+      {
+        if (const F* t = this->template target<F>())
+          return function_equal(*t, f);
+        return false;
+      }
+
+      R operator()(Args... args) const
+      {
+        return invoker(&buffer, static_cast<Args&&>(args)...);
+      }
+
+    private:
+      template<typename F>
+      void assign(const F& f)
+      {
+        // Functions are kept as function pointers
+        typedef typename std::decay<F>::type stored_type;
+        ops<stored_type>::create(f, &buffer);
+        invoker = &invoke<stored_type>;
+        manager = &ops<stored_type>::manager;
+      }
+
+      // Moves the function object of other, which must then be empty,
+      // into this one, which must be empty as well
+      void take(inline_function& other) BOOST_NOEXCEPT
+      {
+        invoker = other.invoker;
+        manager = other.manager;
+        if (manager) {
+          manager->move(&other.buffer, &buffer);
+          other.invoker = &invoke_empty;
+          other.manager = 0;
+        }
+      }
+
+      template<typename F>
+      static R invoke(void* buffer, Args... args)
+      {
+        return unwrap_ref(ops<F>::get(buffer))(static_cast<Args&&>(args)...);
+      }
+
+      static R invoke_empty(void*, Args...)
+      {
+        boost::throw_exception(bad_function_call());
+      }
+
+      invoker_type invoker;
+      const detail::inline_function_manager* manager;
+      mutable typename std::aligned_storage<
+                (BufferSize < sizeof(void*)? sizeof(void*) : BufferSize),
+                std::alignment_of<std::max_align_t>::value>::type buffer;
+    };
+
+    template<typename Signature, std::size_t BufferSize>
+    inline void
+    swap(inline_function<Signature, BufferSize>& f1,
+         inline_function<Signature, BufferSize>& f2)
+    {
+      f1.swap(f2);
+    }
+
+    template<typename Signature, std::size_t BufferSize, typename F>
+    inline typename std::enable_if<!is_inline_function<F>::value, bool>::type
+    operator==(const inline_function<Signature, BufferSize>& f, const F& g)
+    {
+      return f.contains(g);
+    }
+
+    template<typename Signature, std::size_t BufferSize, typename F>
+    inline typename std::enable_if<!is_inline_function<F>::value, bool>::type
+    operator==(const F& g, const inline_function<Signature, BufferSize>& f)
+    {
+      return f.contains(g);
+    }
+
+    template<typename Signature, std::size_t BufferSize, typename F>
+    inline typename std::enable_if<!is_inline_function<F>::value, bool>::type
+    operator!=(const inline_function<Signature, BufferSize>& f, const F& g)
+    {
+      return !f.contains(g);
+    }
+
+    template<typename Signature, std::size_t BufferSize, typename F>
+    inline typename std::enable_if<!is_inline_function<F>::value, bool>::type
+    operator!=(const F& g, const inline_function<Signature, BufferSize>& f)
+    {
+      return !f.contains(g);
+    }
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_INLINE_FUNCTION_HEADER
@@ -0,0 +1,67 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_LOCK_POLICY_HPP
+#define BOOST_SIGNALS_LOCK_POLICY_HPP
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/smart_ptr/detail/spinlock.hpp>
+#include <boost/noncopyable.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    // Selects the lock that guards a signal (the LockPolicy parameter of
+    // the signal class templates). A lock policy is a lock type with
+    // lock() and unlock(), which are used when slots are connected and
+    // disconnected and when a call of the signal starts and ends, and
+    // lock_shared() and unlock_shared(), which are used to step from one
+    // slot to the next while the signal is calling its slots. The lock is
+    // never held while a slot runs. See mutex_lock.hpp for the lock
+    // policies based on Boost.Thread.
+
+    // The signal is not shared between threads, and has no lock at all.
+    // This is the default.
+    class null_lock : noncopyable {
+    public:
+      void lock() {}
+      void unlock() {}
+      void lock_shared() {}
+      void unlock_shared() {}
+    };
+
+    // A spinlock. Calls to the signal step through the slots one at a
+    // time.
+    class spin_lock : noncopyable {
+    public:
+      spin_lock()
+      {
+        boost::detail::spinlock init = BOOST_DETAIL_SPINLOCK_INIT;
+        spinlock = init;
+      }
+
+      void lock() { spinlock.lock(); }
+      void unlock() { spinlock.unlock(); }
+      void lock_shared() { spinlock.lock(); }
+      void unlock_shared() { spinlock.unlock(); }
+
+    private:
+      boost::detail::spinlock spinlock;
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_LOCK_POLICY_HPP
@@ -0,0 +1,57 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_MUTEX_LOCK_HPP
+#define BOOST_SIGNALS_MUTEX_LOCK_HPP
+
+// Lock policies based on Boost.Thread, which programs that use them must
+// link with.
+
+#include <boost/signals/lock_policy.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    // A mutex. Calls to the signal step through the slots one at a time.
+    class mutex_lock : noncopyable {
+    public:
+      void lock() { mutex.lock(); }
+      void unlock() { mutex.unlock(); }
+      void lock_shared() { mutex.lock(); }
+      void unlock_shared() { mutex.unlock(); }
+
+    private:
+      boost::mutex mutex;
+    };
+
+    // A reader-writer lock: any number of threads may step through the
+    // slots of the signal at once.
+    class shared_mutex_lock : noncopyable {
+    public:
+      void lock() { mutex.lock(); }
+      void unlock() { mutex.unlock(); }
+      void lock_shared() { mutex.lock_shared(); }
+      void unlock_shared() { mutex.unlock_shared(); }
+
+    private:
+      boost::shared_mutex mutex;
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_MUTEX_LOCK_HPP
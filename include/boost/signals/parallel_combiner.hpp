@@ -0,0 +1,170 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_PARALLEL_COMBINER_HEADER
+#define BOOST_SIGNALS_PARALLEL_COMBINER_HEADER
+
+// A combiner that calls the slots concurrently. It is based on
+// Boost.Thread, which programs that use it must link with.
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <vector>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // The calls of the slots during one call of the signal, shared by
+      // the calling thread and the tasks given to the executor. Each
+      // thread claims the next slot that nobody has called yet, until
+      // there are none left, so a task that runs late finds nothing to
+      // do and the calling thread never waits for a task that has not
+      // started.
+      template<typename InputIterator>
+      class parallel_calls : noncopyable {
+      public:
+        explicit parallel_calls(const std::vector<InputIterator>& s) :
+          slots(&s), count(s.size()), next(0), finished(0)
+        {
+        }
+
+        void run()
+        {
+          for (;;) {
+            std::size_t i;
+            {
+              boost::mutex::scoped_lock lock(mutex);
+              if (next == count)
+                return;
+              i = next++;
+            }
+
+            // The calling thread waits for the slot, so the iterators
+            // are still there. The result is cached in the iterator.
+            exception_ptr failure;
+            try {
+              *(*slots)[i];
+            } catch (...) {
+              failure = current_exception();
+            }
+
+            boost::mutex::scoped_lock lock(mutex);
+            if (failure && !error)
+              error = failure;
+            if (++finished == count)
+              done.notify_all();
+          }
+        }
+
+        // Waits for the slots to return, and rethrows the first exception
+        // that one of them threw
+        void wait()
+        {
+          boost::mutex::scoped_lock lock(mutex);
+          while (finished != count)
+            done.wait(lock);
+          if (error)
+            rethrow_exception(error);
+        }
+
+      private:
+        const std::vector<InputIterator>* slots;
+        std::size_t count;
+        std::size_t next;
+        std::size_t finished;
+        exception_ptr error;
+        boost::mutex mutex;
+        boost::condition_variable done;
+      };
+
+      template<typename InputIterator>
+      struct parallel_task {
+        typedef shared_ptr<parallel_calls<InputIterator> > calls_pointer;
+
+        explicit parallel_task(const calls_pointer& c) : calls(c) {}
+
+        void operator()() const { calls->run(); }
+
+        calls_pointer calls;
+      };
+    } // end namespace detail
+
+    // Calls all of the slots concurrently, on the threads of the given
+    // executor and on the calling thread, and then passes their results,
+    // in the usual order, to the given combiner. The executor is a
+    // function object that is passed a nullary function object and runs
+    // it once, on any thread, such as by posting it to a thread pool.
+    //
+    // Every slot is called before the combiner sees any result, so a
+    // combiner that stops early does not save any calls. The slots must
+    // not depend on each other, must be safe to call from any thread and
+    // must not modify their arguments, which they share.
+    template<typename Combiner, typename Executor>
+    struct parallel_combiner {
+      typedef typename Combiner::result_type result_type;
+
+      explicit parallel_combiner(const Executor& e = Executor(),
+                                 const Combiner& c = Combiner()) :
+        executor(e), combiner(c)
+      {
+      }
+
+      template<typename InputIterator>
+      result_type operator()(InputIterator first, InputIterator last) const
+      {
+        // A copy of the iterator for each slot, in which the slot's
+        // result is kept
+        std::vector<InputIterator> slots;
+        for (; first != last; ++first)
+          slots.push_back(first);
+
+        if (slots.size() > 1) {
+          typedef detail::parallel_calls<InputIterator> calls_type;
+          shared_ptr<calls_type> calls(new calls_type(slots));
+          try {
+            for (std::size_t i = 1; i < slots.size(); ++i)
+              executor(detail::parallel_task<InputIterator>(calls));
+          } catch (...) {
+            // The tasks already given to the executor may still call
+            // slots, which must be done before the iterators go away
+            calls->run();
+            calls->wait();
+            throw;
+          }
+          calls->run();
+          calls->wait();
+        }
+
+        typedef typename std::vector<InputIterator>::const_iterator
+          slot_iterator;
+        return combiner(indirect_iterator<slot_iterator>(slots.begin()),
+                        indirect_iterator<slot_iterator>(slots.end()));
+      }
+
+      Executor executor;
+      Combiner combiner;
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_PARALLEL_COMBINER_HEADER
@@ -0,0 +1,348 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_QUEUED_SIGNAL_HEADER
+#define BOOST_SIGNALS_QUEUED_SIGNAL_HEADER
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+    || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#  error "boost/signals/queued_signal.hpp requires variadic templates"
+#endif
+
+#include <boost/signal.hpp>
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/detail/variadic_signal.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/smart_ptr/detail/spinlock.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    namespace detail {
+      // A call of a queued signal, waiting in a dispatcher to be
+      // delivered
+      class queued_call : noncopyable {
+      public:
+        queued_call() : next(0) {}
+        virtual ~queued_call() {}
+
+        // Calls the signal with the stored arguments, and then hands the
+        // call back to the signal to be reused. If the signal is gone,
+        // deletes the call instead and returns false.
+        virtual bool deliver() = 0;
+
+        queued_call* next;
+      };
+
+      // The calls of a queued signal that are not waiting in the
+      // dispatcher, kept to be reused along with the storage of their
+      // arguments. The calls still waiting keep it alive.
+      class queued_call_pool : noncopyable {
+      public:
+        queued_call_pool() : calls(0), closed(false)
+        {
+          boost::detail::spinlock init = BOOST_DETAIL_SPINLOCK_INIT;
+          spinlock = init;
+        }
+
+        ~queued_call_pool() { delete_calls(calls); }
+
+        // Returns a call to reuse, or 0 if there is none
+        queued_call* take()
+        {
+          boost::detail::spinlock::scoped_lock lock(spinlock);
+          queued_call* call = calls;
+          if (call)
+            calls = call->next;
+          return call;
+        }
+
+        // Returns whether the call was kept; it is not once the signal
+        // is gone
+        bool give_back(queued_call* call)
+        {
+          boost::detail::spinlock::scoped_lock lock(spinlock);
+          if (closed.load(memory_order_relaxed))
+            return false;
+          call->next = calls;
+          calls = call;
+          return true;
+        }
+
+        // Called when the signal goes away. The calls that are waiting
+        // in the dispatcher will delete themselves.
+        void close()
+        {
+          queued_call* kept;
+          {
+            boost::detail::spinlock::scoped_lock lock(spinlock);
+            closed.store(true, memory_order_release);
+            kept = calls;
+            calls = 0;
+          }
+          delete_calls(kept);
+        }
+
+        bool is_closed() const { return closed.load(memory_order_acquire); }
+
+      private:
+        static void delete_calls(queued_call* call)
+        {
+          while (call) {
+            queued_call* next = call->next;
+            delete call;
+            call = next;
+          }
+        }
+
+        boost::detail::spinlock spinlock;
+        queued_call* calls;
+
+        // Written under the spinlock, but also read without it by calls
+        // that are about to be delivered
+        boost::atomic<bool> closed;
+      };
+
+      // How an argument of a queued signal is stored until the call is
+      // delivered
+      template<typename T>
+      struct queued_argument {
+        typedef typename std::remove_cv<
+                  typename std::remove_reference<T>::type>::type type;
+      };
+
+      template<typename Signal, typename... Args>
+      class queued_signal_call : public queued_call {
+      public:
+        typedef std::tuple<typename queued_argument<Args>::type...>
+          arguments_type;
+
+        queued_signal_call(Signal* s, const shared_ptr<queued_call_pool>& p,
+                           const typename queued_argument<Args>::type&... a)
+          : signal(s), pool(p), args(a...)
+        {
+        }
+
+        // Stores the arguments of another call, assigning them over the
+        // previous ones so that their storage can be reused
+        void assign(const typename queued_argument<Args>::type&... a)
+        {
+          args = std::forward_as_tuple(a...);
+        }
+
+        bool deliver()
+        {
+          if (pool->is_closed()) {
+            delete this;
+            return false;
+          }
+
+          // The call is given back even when a slot throws
+          struct give_back_guard {
+            ~give_back_guard()
+            {
+              if (!call->pool->give_back(call))
+                delete call;
+            }
+            queued_signal_call* call;
+          } guard = { this };
+
+          invoke(typename make_index_list<sizeof...(Args)>::type());
+          return true;
+        }
+
+      private:
+        template<std::size_t... I>
+        void invoke(index_list<I...>)
+        {
+          (*signal)(static_cast<typename forwarded_argument<Args>::type>(
+                      std::get<I>(args))...);
+        }
+
+        Signal* signal;
+        shared_ptr<queued_call_pool> pool;
+        arguments_type args;
+      };
+    } // end namespace detail
+
+    // Delivers the calls posted to queued signals, on the thread that
+    // runs it. Any number of threads may post calls at once, without
+    // waiting for each other or for the dispatcher; only one thread at a
+    // time may run the dispatcher.
+    class dispatcher : noncopyable {
+    public:
+      dispatcher() : posted(0), pending(0) {}
+
+      // Calls that have not been delivered are discarded
+      ~dispatcher()
+      {
+        discard(pending);
+        discard(posted.exchange(0, memory_order_acquire));
+      }
+
+      // Delivers the calls posted so far, in the order in which each
+      // thread posted them, and returns their number. If a slot throws,
+      // the exception is passed on and the calls that remain are
+      // delivered by the next run.
+      std::size_t run()
+      {
+        // The calls are posted onto a stack, which is taken as a whole
+        // and reversed to restore the order of posting
+        detail::queued_call* batch = 0;
+        detail::queued_call* top = posted.exchange(0, memory_order_acquire);
+        while (top) {
+          detail::queued_call* next = top->next;
+          top->next = batch;
+          batch = top;
+          top = next;
+        }
+
+        // The calls left over when a slot threw go first
+        detail::queued_call** end = &pending;
+        while (*end)
+          end = &(*end)->next;
+        *end = batch;
+
+        std::size_t delivered = 0;
+        while (pending) {
+          detail::queued_call* call = pending;
+          pending = call->next;
+          if (call->deliver())
+            ++delivered;
+        }
+        return delivered;
+      }
+
+      // Adds the call to the calls to deliver
+      void post(detail::queued_call* call)
+      {
+        detail::queued_call* top = posted.load(memory_order_relaxed);
+        do {
+          call->next = top;
+        } while (!posted.compare_exchange_weak(top, call,
+                                               memory_order_release,
+                                               memory_order_relaxed));
+      }
+
+    private:
+      static void discard(detail::queued_call* call)
+      {
+        while (call) {
+          detail::queued_call* next = call->next;
+          delete call;
+          call = next;
+        }
+      }
+
+      boost::atomic<detail::queued_call*> posted;
+
+      // Calls taken from the stack but not delivered yet, in order. Only
+      // the thread that runs the dispatcher uses these.
+      detail::queued_call* pending;
+    };
+
+    // A signal that may also be called through a dispatcher: post()
+    // copies the arguments and returns at once, and the slots are called
+    // with the copies when the dispatcher runs. The calls are reused,
+    // along with the storage of their arguments, so a signal that is
+    // posted to steadily stops allocating. The results of the slots are
+    // discarded.
+    //
+    // The dispatcher must outlive the signal. The signal must not be
+    // destroyed while the dispatcher is running, or while calls are
+    // being posted to it; calls that have not been delivered by then are
+    // dropped.
+    template<
+      typename Signature,
+      typename Combiner =
+        typename detail::default_combiner<Signature>::type,
+      typename Group = int,
+      typename GroupCompare = std::less<Group>,
+      typename SlotFunction = function<Signature>,
+      typename SlotStorage = flat_slot_storage,
+      typename LockPolicy = null_lock,
+      typename Allocator = std::allocator<void>
+    >
+    class queued_signal;
+
+    template<typename R, typename... Args, typename Combiner, typename Group,
+             typename GroupCompare, typename SlotFunction,
+             typename SlotStorage, typename LockPolicy, typename Allocator>
+    class queued_signal<R (Args...), Combiner, Group, GroupCompare,
+                        SlotFunction, SlotStorage, LockPolicy, Allocator> :
+      public boost::signal<R (Args...), Combiner, Group, GroupCompare,
+                           SlotFunction, SlotStorage, LockPolicy, Allocator>
+    {
+      typedef boost::signal<R (Args...), Combiner, Group, GroupCompare,
+                            SlotFunction, SlotStorage, LockPolicy, Allocator>
+        base_type;
+      typedef detail::queued_signal_call<base_type, Args...> call_type;
+
+    public:
+      explicit queued_signal(dispatcher& d,
+                             const Combiner& combiner = Combiner(),
+                             const GroupCompare& group_compare =
+                               GroupCompare()) :
+        base_type(combiner, group_compare), target(&d),
+        pool(new detail::queued_call_pool)
+      {
+      }
+
+      ~queued_signal() { pool->close(); }
+
+      // Queues a call of the signal with copies of the arguments
+      void post(const typename detail::queued_argument<Args>::type&... args)
+      {
+        call_type* call = static_cast<call_type*>(pool->take());
+        if (call) {
+          // The call goes back to the pool if the arguments cannot be
+          // stored
+          struct take_guard {
+            ~take_guard()
+            {
+              if (call && !pool->give_back(call))
+                delete call;
+            }
+            detail::queued_call_pool* pool;
+            call_type* call;
+          } guard = { pool.get(), call };
+
+          call->assign(args...);
+          guard.call = 0;
+        }
+        else {
+          call = new call_type(this, pool, args...);
+        }
+        target->post(call);
+      }
+
+      dispatcher& get_dispatcher() const { return *target; }
+
+    private:
+      dispatcher* target;
+      shared_ptr<detail::queued_call_pool> pool;
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_QUEUED_SIGNAL_HEADER
@@ -10,6 +10,27 @@
 #ifndef BOOST_SIGNALS_SIGNAL0_HEADER
 #define BOOST_SIGNALS_SIGNAL0_HEADER
 
+#include <boost/signals/detail/config.hpp>
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+#  include <boost/signals/detail/variadic_signal.hpp>
+#  include <boost/function/function0.hpp>
+
+namespace boost {
+  template<typename R,
+           typename Combiner = last_value<R>,
+           typename Group = int,
+           typename GroupCompare = std::less<Group>,
+           typename SlotFunction = function0<R>,
+           typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+           typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,
+           typename Allocator = std::allocator<void> >
+  using signal0 =
+    BOOST_SIGNALS_NAMESPACE::detail::variadic_signal<
+      R (), Combiner, Group, GroupCompare, SlotFunction,
+      SlotStorage, LockPolicy, Allocator>;
+} // end namespace boost
+#else
 #define BOOST_SIGNALS_NUM_ARGS 0
 #define BOOST_SIGNALS_TEMPLATE_PARMS
 #define BOOST_SIGNALS_TEMPLATE_ARGS
@@ -17,7 +38,7 @@
 #define BOOST_SIGNALS_ARGS
 #define BOOST_SIGNALS_BOUND_ARGS
 #define BOOST_SIGNALS_ARGS_AS_MEMBERS
-#define BOOST_SIGNALS_COPY_PARMS
+#define BOOST_SIGNALS_REF_PARMS
 #define BOOST_SIGNALS_INIT_ARGS
 #define BOOST_SIGNALS_ARG_TYPES
 
@@ -25,7 +46,7 @@
 
 #undef BOOST_SIGNALS_ARG_TYPES
 #undef BOOST_SIGNALS_INIT_ARGS
-#undef BOOST_SIGNALS_COPY_PARMS
+#undef BOOST_SIGNALS_REF_PARMS
 #undef BOOST_SIGNALS_ARGS_AS_MEMBERS
 #undef BOOST_SIGNALS_BOUND_ARGS
 #undef BOOST_SIGNALS_ARGS
@@ -33,5 +54,6 @@
 #undef BOOST_SIGNALS_TEMPLATE_ARGS
 #undef BOOST_SIGNALS_TEMPLATE_PARMS
 #undef BOOST_SIGNALS_NUM_ARGS
+#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
 
 #endif // BOOST_SIGNALS_SIGNAL0_HEADER
@@ -10,14 +10,35 @@
 #ifndef BOOST_SIGNALS_SIGNAL1_HEADER
 #define BOOST_SIGNALS_SIGNAL1_HEADER
 
+#include <boost/signals/detail/config.hpp>
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+#  include <boost/signals/detail/variadic_signal.hpp>
+#  include <boost/function/function1.hpp>
+
+namespace boost {
+  template<typename R, typename T1,
+           typename Combiner = last_value<R>,
+           typename Group = int,
+           typename GroupCompare = std::less<Group>,
+           typename SlotFunction = function1<R, T1>,
+           typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+           typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,
+           typename Allocator = std::allocator<void> >
+  using signal1 =
+    BOOST_SIGNALS_NAMESPACE::detail::variadic_signal<
+      R (T1), Combiner, Group, GroupCompare, SlotFunction,
+      SlotStorage, LockPolicy, Allocator>;
+} // end namespace boost
+#else
 #define BOOST_SIGNALS_NUM_ARGS 1
 #define BOOST_SIGNALS_TEMPLATE_PARMS typename T1
 #define BOOST_SIGNALS_TEMPLATE_ARGS T1
 #define BOOST_SIGNALS_PARMS T1 a1
 #define BOOST_SIGNALS_ARGS a1
 #define BOOST_SIGNALS_BOUND_ARGS args->a1
-#define BOOST_SIGNALS_ARGS_AS_MEMBERS T1 a1;
-#define BOOST_SIGNALS_COPY_PARMS T1 ia1
+#define BOOST_SIGNALS_ARGS_AS_MEMBERS typename add_reference<T1>::type a1;
+#define BOOST_SIGNALS_REF_PARMS typename add_reference<T1>::type ia1
 #define BOOST_SIGNALS_INIT_ARGS :a1(ia1)
 #define BOOST_SIGNALS_ARG_TYPES typedef T1 arg1_type;
 
@@ -25,7 +46,7 @@
 
 #undef BOOST_SIGNALS_ARG_TYPES
 #undef BOOST_SIGNALS_INIT_ARGS
-#undef BOOST_SIGNALS_COPY_PARMS
+#undef BOOST_SIGNALS_REF_PARMS
 #undef BOOST_SIGNALS_ARGS_AS_MEMBERS
 #undef BOOST_SIGNALS_BOUND_ARGS
 #undef BOOST_SIGNALS_ARGS
@@ -33,5 +54,6 @@
 #undef BOOST_SIGNALS_TEMPLATE_ARGS
 #undef BOOST_SIGNALS_TEMPLATE_PARMS
 #undef BOOST_SIGNALS_NUM_ARGS
+#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
 
 #endif // BOOST_SIGNALS_SIGNAL1_HEADER
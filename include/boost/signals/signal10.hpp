@@ -10,14 +10,39 @@
 #ifndef BOOST_SIGNALS_SIGNAL10_HEADER
 #define BOOST_SIGNALS_SIGNAL10_HEADER
 
+#include <boost/signals/detail/config.hpp>
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+#  include <boost/signals/detail/variadic_signal.hpp>
+#  include <boost/function/function10.hpp>
+
+namespace boost {
+  template<typename R, typename T1, typename T2, typename T3, typename T4,
+           typename T5, typename T6, typename T7, typename T8, typename T9,
+           typename T10,
+           typename Combiner = last_value<R>,
+           typename Group = int,
+           typename GroupCompare = std::less<Group>,
+           typename SlotFunction =
+             function10<R, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10>,
+           typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+           typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,
+           typename Allocator = std::allocator<void> >
+  using signal10 =
+    BOOST_SIGNALS_NAMESPACE::detail::variadic_signal<
+      R (T1, T2, T3, T4, T5, T6, T7, T8, T9, T10),
+      Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+      LockPolicy, Allocator>;
+} // end namespace boost
+#else
 #define BOOST_SIGNALS_NUM_ARGS 10
 #define BOOST_SIGNALS_TEMPLATE_PARMS typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10
 #define BOOST_SIGNALS_TEMPLATE_ARGS T1, T2, T3, T4, T5, T6, T7, T8, T9, T10
 #define BOOST_SIGNALS_PARMS T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, T9 a9, T10 a10
 #define BOOST_SIGNALS_ARGS a1, a2, a3, a4, a5, a6, a7, a8, a9, a10
 #define BOOST_SIGNALS_BOUND_ARGS args->a1, args->a2, args->a3, args->a4, args->a5, args->a6, args->a7, args->a8, args->a9, args->a10
-#define BOOST_SIGNALS_ARGS_AS_MEMBERS T1 a1;T2 a2;T3 a3;T4 a4;T5 a5;T6 a6;T7 a7;T8 a8;T9 a9;T10 a10;
-#define BOOST_SIGNALS_COPY_PARMS T1 ia1, T2 ia2, T3 ia3, T4 ia4, T5 ia5, T6 ia6, T7 ia7, T8 ia8, T9 ia9, T10 ia10
+#define BOOST_SIGNALS_ARGS_AS_MEMBERS typename add_reference<T1>::type a1;typename add_reference<T2>::type a2;typename add_reference<T3>::type a3;typename add_reference<T4>::type a4;typename add_reference<T5>::type a5;typename add_reference<T6>::type a6;typename add_reference<T7>::type a7;typename add_reference<T8>::type a8;typename add_reference<T9>::type a9;typename add_reference<T10>::type a10;
+#define BOOST_SIGNALS_REF_PARMS typename add_reference<T1>::type ia1, typename add_reference<T2>::type ia2, typename add_reference<T3>::type ia3, typename add_reference<T4>::type ia4, typename add_reference<T5>::type ia5, typename add_reference<T6>::type ia6, typename add_reference<T7>::type ia7, typename add_reference<T8>::type ia8, typename add_reference<T9>::type ia9, typename add_reference<T10>::type ia10
 #define BOOST_SIGNALS_INIT_ARGS :a1(ia1), a2(ia2), a3(ia3), a4(ia4), a5(ia5), a6(ia6), a7(ia7), a8(ia8), a9(ia9), a10(ia10)
 #define BOOST_SIGNALS_ARG_TYPES typedef T1 arg1_type; typedef T2 arg2_type; typedef T3 arg3_type; typedef T4 arg4_type; typedef T5 arg5_type; typedef T6 arg6_type; typedef T7 arg7_type; typedef T8 arg8_type; typedef T9 arg9_type; typedef T10 arg10_type;
 
@@ -25,7 +50,7 @@
 
 #undef BOOST_SIGNALS_ARG_TYPES
 #undef BOOST_SIGNALS_INIT_ARGS
-#undef BOOST_SIGNALS_COPY_PARMS
+#undef BOOST_SIGNALS_REF_PARMS
 #undef BOOST_SIGNALS_ARGS_AS_MEMBERS
 #undef BOOST_SIGNALS_BOUND_ARGS
 #undef BOOST_SIGNALS_ARGS
@@ -33,5 +58,6 @@
 #undef BOOST_SIGNALS_TEMPLATE_ARGS
 #undef BOOST_SIGNALS_TEMPLATE_PARMS
 #undef BOOST_SIGNALS_NUM_ARGS
+#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
 
 #endif // BOOST_SIGNALS_SIGNAL10_HEADER
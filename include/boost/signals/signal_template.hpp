@@ -15,15 +15,10 @@
 #ifndef BOOST_SIGNALS_SIGNAL_TEMPLATE_HEADER_INCLUDED
 #define BOOST_SIGNALS_SIGNAL_TEMPLATE_HEADER_INCLUDED
 #  include <boost/config.hpp>
-#  include <boost/signals/connection.hpp>
 #  include <boost/ref.hpp>
-#  include <boost/signals/slot.hpp>
 #  include <boost/last_value.hpp>
-#  include <boost/signals/detail/signal_base.hpp>
-#  include <boost/signals/detail/slot_call_iterator.hpp>
-#  include <boost/mpl/bool.hpp>
-#  include <boost/type_traits/is_convertible.hpp>
-#  include <cassert>
+#  include <boost/signals/detail/basic_signal.hpp>
+#  include <boost/type_traits/add_reference.hpp>
 #  include <functional>
 #  include <memory>
 #endif // !BOOST_SIGNALS_SIGNAL_TEMPLATE_HEADER_INCLUDED
@@ -48,6 +43,7 @@
 #define BOOST_SIGNALS_FUNCTION BOOST_JOIN(function,BOOST_SIGNALS_NUM_ARGS)
 #define BOOST_SIGNALS_ARGS_STRUCT BOOST_JOIN(args,BOOST_SIGNALS_NUM_ARGS)
 #define BOOST_SIGNALS_CALL_BOUND BOOST_JOIN(call_bound,BOOST_SIGNALS_NUM_ARGS)
+#define BOOST_SIGNALS_MEMBER_SLOT BOOST_JOIN(member_slot,BOOST_SIGNALS_NUM_ARGS)
 
 // Define commonly-used instantiations
 #define BOOST_SIGNALS_ARGS_STRUCT_INST \
@@ -56,12 +52,13 @@
 namespace boost {
   namespace BOOST_SIGNALS_NAMESPACE {
     namespace detail {
-      // Holds the arguments for a bound slot call in a single place
+      // Refers to the arguments of a signal call in a single place, so
+      // that they are not copied before being passed to each slot
       template<BOOST_SIGNALS_TEMPLATE_PARMS
                BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
                typename Dummy = int>
       struct BOOST_SIGNALS_ARGS_STRUCT {
-        BOOST_SIGNALS_ARGS_STRUCT(BOOST_SIGNALS_COPY_PARMS)
+        BOOST_SIGNALS_ARGS_STRUCT(BOOST_SIGNALS_REF_PARMS)
           BOOST_SIGNALS_INIT_ARGS
         {
         }
@@ -69,6 +66,27 @@ namespace boost {
         BOOST_SIGNALS_ARGS_AS_MEMBERS
       };
 
+      // Calls a member function of an object, for connect_member
+      template<typename R,
+               BOOST_SIGNALS_TEMPLATE_PARMS
+               BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
+               typename T,
+               typename MemberFunction>
+      struct BOOST_SIGNALS_MEMBER_SLOT {
+        BOOST_SIGNALS_MEMBER_SLOT(T* o, MemberFunction m) :
+          object(o), method(m)
+        {
+        }
+
+        R operator()(BOOST_SIGNALS_PARMS) const
+        {
+          return static_cast<R>((object->*method)(BOOST_SIGNALS_ARGS));
+        }
+
+        T* object;
+        MemberFunction method;
+      };
+
       // Function object that calls the function object given to it, passing
       // the bound arguments along to that underlying function object
       template<typename R>
@@ -87,11 +105,11 @@ namespace boost {
           caller() {}
           caller(args_type a) : args(a) {}
 
-          template<typename Pair>
-          R operator()(const Pair& slot) const
+          template<typename Slot>
+          R operator()(const Slot& slot) const
           {
-            F* target = const_cast<F*>(unsafe_any_cast<F>(&slot.second));
-            return (*target)(BOOST_SIGNALS_BOUND_ARGS);
+            F& target = stored_function<F>(slot);
+            return target(BOOST_SIGNALS_BOUND_ARGS);
           }
         };
       };
@@ -111,13 +129,20 @@ namespace boost {
 
           caller(args_type a) : args(a) {}
 
-          template<typename Pair>
-          unusable operator()(const Pair& slot) const
+          template<typename Slot>
+          unusable operator()(const Slot& slot) const
           {
-            F* target = const_cast<F*>(unsafe_any_cast<F>(&slot.second));
-            (*target)(BOOST_SIGNALS_BOUND_ARGS);
+            call(slot);
             return unusable();
           }
+
+          // Used by the slot call iterator, which has no result to cache
+          template<typename Slot>
+          void call(const Slot& slot) const
+          {
+            F& target = stored_function<F>(slot);
+            target(BOOST_SIGNALS_BOUND_ARGS);
+          }
         };
       };
     } // namespace detail
@@ -133,20 +158,22 @@ namespace boost {
     typename GroupCompare = std::less<Group>,
     typename SlotFunction = BOOST_SIGNALS_FUNCTION<
                               R BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-                              BOOST_SIGNALS_TEMPLATE_ARGS>
+                              BOOST_SIGNALS_TEMPLATE_ARGS>,
+    typename SlotStorage = BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+    typename LockPolicy = BOOST_SIGNALS_NAMESPACE::null_lock,
+    typename Allocator = std::allocator<void>
   >
   class BOOST_SIGNALS_SIGNAL :
-    public BOOST_SIGNALS_NAMESPACE::detail::signal_base, // management of slot list
-    public BOOST_SIGNALS_NAMESPACE::trackable // signals are trackable
+    public BOOST_SIGNALS_NAMESPACE::detail::basic_signal<
+             R, Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+             LockPolicy, Allocator>
   {
-  public:
-    // The slot function type
-    typedef SlotFunction slot_function_type;
-
-    // Result type of a slot
-    typedef typename BOOST_SIGNALS_NAMESPACE::detail::slot_result_type<R>::type
-      slot_result_type;
+    typedef BOOST_SIGNALS_NAMESPACE::detail::basic_signal<
+              R, Combiner, Group, GroupCompare, SlotFunction, SlotStorage,
+              LockPolicy, Allocator>
+      base_type;
 
+  public:
     // Argument types
     BOOST_SIGNALS_ARG_TYPES
 
@@ -157,11 +184,12 @@ namespace boost {
     typedef T2 second_argument_type;
 #endif
 
-  private:
-    // The real slot name comparison object type
-    typedef BOOST_SIGNALS_NAMESPACE::detail::group_bridge_compare<GroupCompare, Group>
-      real_group_compare_type;
+    typedef typename base_type::slot_function_type slot_function_type;
+    typedef typename base_type::result_type result_type;
+    typedef typename base_type::slot_type slot_type;
+    typedef typename base_type::group_type group_type;
 
+  private:
     // The function object passed to the slot call iterator that will call
     // the underlying slot function with its arguments bound
     typedef BOOST_SIGNALS_NAMESPACE::detail::BOOST_SIGNALS_CALL_BOUND<R>
@@ -172,224 +200,78 @@ namespace boost {
                      slot_function_type>
       call_bound_slot;
 
-  public:
-    // Combiner's result type
-    typedef typename Combiner::result_type result_type;
-
-    // Combiner type
-    typedef Combiner combiner_type;
-
-    // Slot type
-    typedef slot<slot_function_type> slot_type;
-
-    // Slot name type and comparison
-    typedef Group group_type;
-    typedef GroupCompare group_compare_type;
+    // The slot of connect_member, which calls the member function of obj
+    template<typename T, typename MemberFunction>
+    static slot_type make_member_slot(T* obj, MemberFunction method)
+    {
+      typedef BOOST_SIGNALS_NAMESPACE::detail::BOOST_SIGNALS_MEMBER_SLOT<
+                R, BOOST_SIGNALS_TEMPLATE_ARGS
+                BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS T, MemberFunction>
+        caller;
+      return slot_type(caller(obj, method), obj);
+    }
 
+  public:
     typedef BOOST_SIGNALS_NAMESPACE::detail::slot_call_iterator<
-              call_bound_slot, iterator> slot_call_iterator;
+              call_bound_slot, typename base_type::iterator>
+      slot_call_iterator;
 
     explicit
     BOOST_SIGNALS_SIGNAL(const Combiner& c = Combiner(),
                          const GroupCompare& comp = GroupCompare()) :
-      BOOST_SIGNALS_NAMESPACE::detail::signal_base(real_group_compare_type(comp),
-                                                   c)
+      base_type(c, comp)
     {
     }
 
-    // Connect a slot to this signal
-    BOOST_SIGNALS_NAMESPACE::connection
-    connect(const slot_type&,
-            BOOST_SIGNALS_NAMESPACE::connect_position at
-              = BOOST_SIGNALS_NAMESPACE::at_back);
-
 
+    // Connect a member function of obj, without binding it; the slot is
+    // disconnected when obj is destroyed if obj is trackable
+    template<typename T, typename MemberFunction>
     BOOST_SIGNALS_NAMESPACE::connection
-    connect(const group_type&, const slot_type&,
-            BOOST_SIGNALS_NAMESPACE::connect_position at
-              = BOOST_SIGNALS_NAMESPACE::at_back);
-
-    template<typename T>
-    void disconnect(const T& t)
+    connect_member(T* obj, MemberFunction method,
+                   BOOST_SIGNALS_NAMESPACE::connect_position at =
+                     BOOST_SIGNALS_NAMESPACE::at_back)
     {
-      typedef mpl::bool_<(is_convertible<T, group_type>::value)> is_group;
-      this->do_disconnect(t, is_group());
+      return this->connect(make_member_slot(obj, method), at);
     }
 
-  private:
-    // Disconnect a named slot
-    void do_disconnect(const group_type& group, mpl::bool_<true>)
-    {
-      impl->disconnect(group);
-    }
-
-    template<typename Function>
-    void do_disconnect(const Function& f, mpl::bool_<false>)
+    template<typename T, typename MemberFunction>
+    BOOST_SIGNALS_NAMESPACE::connection
+    connect_member(const group_type& group, T* obj, MemberFunction method,
+                   BOOST_SIGNALS_NAMESPACE::connect_position at =
+                     BOOST_SIGNALS_NAMESPACE::at_back)
     {
-      // Notify the slot handling code that we are iterating through the slots
-      BOOST_SIGNALS_NAMESPACE::detail::call_notification notification(this->impl);
-
-      for (iterator i = impl->slots_.begin(); i != impl->slots_.end(); ++i) {
-        slot_function_type& s = *unsafe_any_cast<slot_function_type>(&i->second);
-        if (s == f) i->first.disconnect();
-      }
+      return this->connect(group, make_member_slot(obj, method), at);
     }
 
-  public:
-
     // Emit the signal
-    result_type operator()(BOOST_SIGNALS_PARMS);
-    result_type operator()(BOOST_SIGNALS_PARMS) const;
-
-    Combiner& combiner()
-    { return *unsafe_any_cast<Combiner>(&impl->combiner_); }
-
-    const Combiner& combiner() const
-    { return *unsafe_any_cast<const Combiner>(&impl->combiner_); }
-  };
-
-  template<
-    typename R,
-    BOOST_SIGNALS_TEMPLATE_PARMS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    typename Combiner,
-    typename Group,
-    typename GroupCompare,
-    typename SlotFunction
-  >
-  BOOST_SIGNALS_NAMESPACE::connection
-  BOOST_SIGNALS_SIGNAL<
-    R, BOOST_SIGNALS_TEMPLATE_ARGS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    Combiner, Group, GroupCompare, SlotFunction
-  >::connect(const slot_type& in_slot,
-             BOOST_SIGNALS_NAMESPACE::connect_position at)
-  {
-    using boost::BOOST_SIGNALS_NAMESPACE::detail::stored_group;
-
-    // If the slot has been disconnected, just return a disconnected
-    // connection
-    if (!in_slot.is_active()) {
-      return BOOST_SIGNALS_NAMESPACE::connection();
-    }
-
-    return impl->connect_slot(in_slot.get_slot_function(), stored_group(),
-                              in_slot.get_data(), at);
-  }
-
-  template<
-    typename R,
-    BOOST_SIGNALS_TEMPLATE_PARMS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    typename Combiner,
-    typename Group,
-    typename GroupCompare,
-    typename SlotFunction
-  >
-  BOOST_SIGNALS_NAMESPACE::connection
-  BOOST_SIGNALS_SIGNAL<
-    R, BOOST_SIGNALS_TEMPLATE_ARGS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    Combiner, Group, GroupCompare, SlotFunction
-  >::connect(const group_type& group,
-             const slot_type& in_slot,
-             BOOST_SIGNALS_NAMESPACE::connect_position at)
-  {
-    // If the slot has been disconnected, just return a disconnected
-    // connection
-    if (!in_slot.is_active()) {
-      return BOOST_SIGNALS_NAMESPACE::connection();
-    }
-
-    return impl->connect_slot(in_slot.get_slot_function(), group,
-                              in_slot.get_data(), at);
-  }
-
-  template<
-    typename R,
-    BOOST_SIGNALS_TEMPLATE_PARMS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    typename Combiner,
-    typename Group,
-    typename GroupCompare,
-    typename SlotFunction
-  >
-  typename BOOST_SIGNALS_SIGNAL<
-             R, BOOST_SIGNALS_TEMPLATE_ARGS
-             BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-             Combiner, Group, GroupCompare, SlotFunction>::result_type
-  BOOST_SIGNALS_SIGNAL<
-    R, BOOST_SIGNALS_TEMPLATE_ARGS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    Combiner, Group, GroupCompare, SlotFunction
-  >::operator()(BOOST_SIGNALS_PARMS)
-  {
-    // Notify the slot handling code that we are making a call
-    BOOST_SIGNALS_NAMESPACE::detail::call_notification notification(this->impl);
-
-    // Construct a function object that will call the underlying slots
-    // with the given arguments.
+    result_type operator()(BOOST_SIGNALS_PARMS)
+    {
+      // Construct a function object that will call the underlying slots
+      // with the given arguments.
 #if BOOST_SIGNALS_NUM_ARGS == 0
-    BOOST_SIGNALS_ARGS_STRUCT_INST args;
+      BOOST_SIGNALS_ARGS_STRUCT_INST args;
 #else
-    BOOST_SIGNALS_ARGS_STRUCT_INST args(BOOST_SIGNALS_ARGS);
+      BOOST_SIGNALS_ARGS_STRUCT_INST args(BOOST_SIGNALS_ARGS);
 #endif // BOOST_SIGNALS_NUM_ARGS > 0
-    call_bound_slot f(&args);
-
-    typedef typename call_bound_slot::result_type call_result_type;
-    optional<call_result_type> cache;
-    // Let the combiner call the slots via a pair of input iterators
-    return combiner()(slot_call_iterator(notification.impl->slots_.begin(),
-                                         impl->slots_.end(), f, cache),
-                      slot_call_iterator(notification.impl->slots_.end(),
-                                         impl->slots_.end(), f, cache));
-  }
-
-  template<
-    typename R,
-    BOOST_SIGNALS_TEMPLATE_PARMS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    typename Combiner,
-    typename Group,
-    typename GroupCompare,
-    typename SlotFunction
-  >
-  typename BOOST_SIGNALS_SIGNAL<
-             R, BOOST_SIGNALS_TEMPLATE_ARGS
-             BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-             Combiner, Group, GroupCompare, SlotFunction>::result_type
-  BOOST_SIGNALS_SIGNAL<
-    R, BOOST_SIGNALS_TEMPLATE_ARGS
-    BOOST_SIGNALS_COMMA_IF_NONZERO_ARGS
-    Combiner, Group, GroupCompare, SlotFunction
-  >::operator()(BOOST_SIGNALS_PARMS) const
-  {
-    // Notify the slot handling code that we are making a call
-    BOOST_SIGNALS_NAMESPACE::detail::call_notification notification(this->impl);
+      return this->call_slots(call_bound_slot(&args));
+    }
 
-    // Construct a function object that will call the underlying slots
-    // with the given arguments.
+    result_type operator()(BOOST_SIGNALS_PARMS) const
+    {
 #if BOOST_SIGNALS_NUM_ARGS == 0
-    BOOST_SIGNALS_ARGS_STRUCT_INST args;
+      BOOST_SIGNALS_ARGS_STRUCT_INST args;
 #else
-    BOOST_SIGNALS_ARGS_STRUCT_INST args(BOOST_SIGNALS_ARGS);
+      BOOST_SIGNALS_ARGS_STRUCT_INST args(BOOST_SIGNALS_ARGS);
 #endif // BOOST_SIGNALS_NUM_ARGS > 0
-
-    call_bound_slot f(&args);
-
-    typedef typename call_bound_slot::result_type call_result_type;
-    optional<call_result_type> cache;
-
-    // Let the combiner call the slots via a pair of input iterators
-    return combiner()(slot_call_iterator(notification.impl->slots_.begin(),
-                                         impl->slots_.end(), f, cache),
-                      slot_call_iterator(notification.impl->slots_.end(),
-                                         impl->slots_.end(), f, cache));
-  }
+      return this->call_slots(call_bound_slot(&args));
+    }
+  };
 } // namespace boost
 
 #undef BOOST_SIGNAL_FUNCTION_N_HEADER
 #undef BOOST_SIGNALS_ARGS_STRUCT_INST
+#undef BOOST_SIGNALS_MEMBER_SLOT
 #undef BOOST_SIGNALS_CALL_BOUND
 #undef BOOST_SIGNALS_ARGS_STRUCT
 #undef BOOST_SIGNALS_FUNCTION
@@ -15,7 +15,9 @@
 #include <boost/signals/trackable.hpp>
 #include <boost/visit_each.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <cassert>
+#include <memory>
 
 #ifdef BOOST_HAS_ABI_HEADERS
 #  include BOOST_ABI_PREFIX
@@ -48,6 +50,10 @@ namespace boost {
         // Create a connection for this slot
         void create_connection();
 
+        // Create a connection for this slot, using the given (newly
+        // allocated) basic_connection
+        void create_connection(basic_connection* con);
+
         shared_ptr<data_t> data;
 
       private:
@@ -101,16 +107,22 @@ namespace boost {
 
   } // end namespace BOOST_SIGNALS_NAMESPACE
 
-  template<typename SlotFunction>
+  // Allocator is the allocator of the signal the slot is meant for, which
+  // allocates the data that tracks the slot and its connection
+  template<typename SlotFunction, typename Allocator = std::allocator<void> >
   class slot : public BOOST_SIGNALS_NAMESPACE::detail::slot_base {
     typedef BOOST_SIGNALS_NAMESPACE::detail::slot_base inherited;
     typedef typename inherited::data_t data_t;
+    typedef typename BOOST_SIGNALS_NAMESPACE::detail::
+              rebind_allocator<Allocator, data_t>::type data_allocator;
+    typedef BOOST_SIGNALS_NAMESPACE::detail::
+              basic_connection_allocator<Allocator> connection_allocator;
 
   public:
     template<typename F>
     slot(const F& f) : slot_function(BOOST_SIGNALS_NAMESPACE::get_invocable_slot(f, BOOST_SIGNALS_NAMESPACE::tag_type(f)))
     {
-      this->data.reset(new data_t);
+      this->data = boost::allocate_shared<data_t>(data_allocator());
 
       // Visit each of the bound objects and store them for later use
       // An exception thrown here will allow the basic_connection to be
@@ -121,15 +133,29 @@ namespace boost {
       visit_each(do_bind, 
                  BOOST_SIGNALS_NAMESPACE::get_inspectable_slot
                    (f, BOOST_SIGNALS_NAMESPACE::tag_type(f)));
-      create_connection();
+      create_connection(connection_allocator::create());
+    }
+
+    // Create a slot that calls f, which is bound to the given object
+    // alone: the slot tracks the object if it is trackable, without
+    // visiting f
+    template<typename F, typename T>
+    slot(const F& f, T* object) : slot_function(f)
+    {
+      this->data = boost::allocate_shared<data_t>(data_allocator());
+
+      BOOST_SIGNALS_NAMESPACE::detail::bound_objects_visitor
+        do_bind(this->data->bound_objects);
+      do_bind(object);
+      create_connection(connection_allocator::create());
     }
 
 #ifdef __BORLANDC__
     template<typename F>
     slot(F* f) : slot_function(f)
     {
-      this->data.reset(new data_t);
-      create_connection();
+      this->data = boost::allocate_shared<data_t>(data_allocator());
+      create_connection(connection_allocator::create());
     }
 #endif // __BORLANDC__
 
@@ -0,0 +1,120 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS_SLOT_STORAGE_HPP
+#define BOOST_SIGNALS_SLOT_STORAGE_HPP
+
+#include <boost/signals/detail/signals_common.hpp>
+#include <boost/signals/lock_policy.hpp>
+#include <boost/signals/detail/named_slot_map.hpp>
+#include <boost/signals/detail/flat_slot_map.hpp>
+#include <boost/signals/detail/snapshot_slot_map.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <functional>
+
+#ifndef BOOST_SIGNALS_DENSE_GROUP_LIMIT
+#  define BOOST_SIGNALS_DENSE_GROUP_LIMIT 16
+#endif
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+
+namespace boost {
+  namespace BOOST_SIGNALS_NAMESPACE {
+    // Selects how a signal stores its slots (the SlotStorage parameter of
+    // the signal class templates).
+    // map_type<SlotFunction, Group, GroupCompare, Allocator>::type is the
+    // slot container of a signal with the given slot function type, group
+    // names and allocator, and lock_type<LockPolicy>::type the lock a
+    // signal with the given LockPolicy actually uses.
+
+    // Flat slot storage finds the groups named by integers in
+    // [0, value) through a table indexed by name, rather than by
+    // searching. The table holds one pointer per name and is allocated
+    // with the first such group. By default, that is done for integral
+    // group types ordered by std::less, with a limit of
+    // BOOST_SIGNALS_DENSE_GROUP_LIMIT; specialize this for other limits,
+    // or set value to 0 to turn the table off.
+    template<typename Group, typename GroupCompare>
+    struct dense_group_limit {
+      BOOST_STATIC_CONSTANT(int, value = 0);
+    };
+
+    template<typename Group>
+    struct dense_group_limit<Group, std::less<Group> > {
+      BOOST_STATIC_CONSTANT(int, value =
+        (is_integral<Group>::value? BOOST_SIGNALS_DENSE_GROUP_LIMIT : 0));
+    };
+
+    // Slots, including their slot functions, are stored contiguously,
+    // group by group. This is the default.
+    struct flat_slot_storage {
+      template<typename SlotFunction, typename Group, typename GroupCompare,
+               typename Allocator>
+      struct map_type {
+        typedef detail::flat_slot_map<
+                  SlotFunction, Group, GroupCompare, Allocator,
+                  dense_group_limit<Group, GroupCompare>::value> type;
+      };
+
+      template<typename LockPolicy>
+      struct lock_type {
+        typedef LockPolicy type;
+      };
+    };
+
+    // Each slot is stored in its own list node, with a std::map from
+    // groups to lists of slots. Slot functions are stored in a boost::any,
+    // and groups are compared through a boost::function. The nodes are
+    // allocated with the global operator new, whatever the allocator of
+    // the signal.
+    struct node_slot_storage {
+      template<typename SlotFunction, typename Group, typename GroupCompare,
+               typename Allocator>
+      struct map_type {
+        typedef detail::node_slot_map<SlotFunction, Group, GroupCompare,
+                                      Allocator> type;
+      };
+
+      template<typename LockPolicy>
+      struct lock_type {
+        typedef LockPolicy type;
+      };
+    };
+
+    // Slots are kept in immutable snapshots, so that the signal may be
+    // called, and slots connected and disconnected, from several threads
+    // at once. Calling the signal does not take the signal lock and does
+    // not wait for connecting and disconnecting, which copy the current
+    // snapshot. It is not lock-free, though: the snapshot is loaded with
+    // boost::atomic_load on a shared_ptr, which holds a spinlock from a
+    // global pool for as long as it takes to copy the pointer.
+    struct snapshot_slot_storage {
+      template<typename SlotFunction, typename Group, typename GroupCompare,
+               typename Allocator>
+      struct map_type {
+        typedef detail::snapshot_slot_map<SlotFunction, Group, GroupCompare,
+                                          Allocator> type;
+      };
+
+      // Snapshots synchronize themselves, so the signal needs no lock
+      template<typename LockPolicy>
+      struct lock_type {
+        typedef null_lock type;
+      };
+    };
+  } // end namespace BOOST_SIGNALS_NAMESPACE
+} // end namespace boost
+
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+
+#endif // BOOST_SIGNALS_SLOT_STORAGE_HPP
@@ -14,7 +14,6 @@
 #include <boost/signals/connection.hpp>
 #include <boost/ref.hpp>
 #include <boost/utility/addressof.hpp>
-#include <list>
 #include <vector>
 
 #ifdef BOOST_HAS_ABI_HEADERS
@@ -33,30 +32,34 @@ namespace BOOST_SIGNALS_NAMESPACE {
 
     friend class detail::signal_base_impl;
     friend class detail::slot_base;
-    void signal_connected(connection, BOOST_SIGNALS_NAMESPACE::detail::bound_object&) const;
+    void signal_connected(detail::basic_connection*,
+                          BOOST_SIGNALS_NAMESPACE::detail::bound_object&) const;
 
   protected:
-    trackable() : connected_signals(), dying(false) {}
-    trackable(const trackable&) : connected_signals(), dying(false) {}
+    trackable() { init(); }
+    trackable(const trackable&) { init(); }
     ~trackable();
 
     trackable& operator=(const trackable&)
     {
-      dying = true;
-      connected_signals.clear();
-      dying = false;
+      disconnect_all();
       return *this;
     }
 
   private:
-    typedef std::list<connection> connection_list;
-    typedef connection_list::iterator connection_iterator;
+    void init()
+    {
+      connected_signals.prev = &connected_signals;
+      connected_signals.next = &connected_signals;
+    }
 
-    // List of connections that this object is part of
-    mutable connection_list connected_signals;
+    // Disconnects every connection that this object is part of
+    void disconnect_all();
 
-    // True when the object is being destroyed
-    mutable bool dying;
+    // Head of the list of connections that this object is part of. The
+    // list runs through the bound objects of the connections, and holds
+    // a reference to each connection.
+    mutable detail::trackable_hook connected_signals;
   };
 
   namespace detail {
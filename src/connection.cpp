@@ -122,28 +122,29 @@ namespace boost {
 
     void connection::disconnect() const
     {
-      if (this->connected()) {
-        // Make sure we have a reference to the basic_connection object,
-        // because 'this' may disappear
-        shared_ptr<detail::basic_connection> local_con = con;
-
-        void (*signal_disconnect)(void*, void*) = local_con->signal_disconnect;
-
-        // Note that this connection no longer exists
-        // Order is important here: we could get into an infinite loop if this
-        // isn't cleared before we try the disconnect.
-        local_con->signal_disconnect = 0;
-
-        // Disconnect signal
-        signal_disconnect(local_con->signal, local_con->signal_data);
-
-        // Disconnect all bound objects
-        typedef std::list<BOOST_SIGNALS_NAMESPACE::detail::bound_object>::iterator iterator;
-        for (iterator i = local_con->bound_objects.begin();
-             i != local_con->bound_objects.end(); ++i) {
-          assert(i->disconnect != 0);
-          i->disconnect(i->obj, i->data);
-        }
+      if (!con.get())
+        return;
+
+      // Make sure we have a reference to the basic_connection object,
+      // because 'this' may disappear
+      intrusive_ptr<detail::basic_connection> local_con = con;
+
+      // Note that this connection no longer exists. Only one thread gets
+      // to clear the connected bit, and it alone carries on. Order is
+      // important here: we could get into an infinite loop if this isn't
+      // cleared before we try the disconnect.
+      if (!(local_con->state.fetch_and(~detail::basic_connection::connected_bit)
+            & detail::basic_connection::connected_bit))
+        return;
+
+      // Disconnect signal
+      local_con->signal_disconnect(local_con->signal, local_con.get());
+
+      // Disconnect all bound objects
+      const detail::bound_object_list& bound = local_con->bound_objects;
+      for (std::size_t i = 0; i < bound.size(); ++i) {
+        assert(bound[i].disconnect != 0);
+        bound[i].disconnect(bound[i].obj, bound[i].data);
       }
     }
   } // end namespace boost
@@ -151,5 +152,5 @@ namespace boost {
 
 #ifndef BOOST_MSVC
 // Explicit instantiations to keep everything in the library
-template class std::list<boost::BOOST_SIGNALS_NAMESPACE::detail::bound_object>;
+template class std::vector<boost::BOOST_SIGNALS_NAMESPACE::detail::bound_object>;
 #endif
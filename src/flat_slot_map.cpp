@@ -0,0 +1,70 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#define BOOST_SIGNALS_SOURCE
+
+#include <boost/signals/detail/flat_slot_map.hpp>
+
+namespace boost { namespace BOOST_SIGNALS_NAMESPACE { namespace detail {
+
+flat_slot_group_base::~flat_slot_group_base()
+{
+}
+
+flat_slot_map_base::flat_slot_map_base(flat_slot_group_base* front_group,
+                                       const group_vector_memory& memory)
+  : first_group(front_group),
+    groups(group_vector_allocator<flat_slot_group_base*>(&memory)),
+    slot_count(0), hole_count(0), compacting(false)
+{
+}
+
+flat_slot_map_base::~flat_slot_map_base()
+{
+  for (group_vector::iterator g = groups.begin(); g != groups.end(); ++g)
+    (*g)->destroy();
+}
+
+void flat_slot_map_base::insert_group(group_vector::iterator pos,
+                                      flat_slot_group_base* group)
+{
+  flat_slot_group_base* prev =
+    (pos == groups.begin())? first_group : *(pos - 1);
+  try {
+    groups.insert(pos, group);
+  }
+  catch(...) {
+    group->destroy();
+    throw;
+  }
+
+  // Link the group into calling order. Nothing below can throw.
+  group->next = prev->next;
+  prev->next = group;
+}
+
+void flat_slot_map_base::remove_empty_groups()
+{
+  flat_slot_group_base* prev = first_group;
+  group_vector::iterator out = groups.begin();
+  for (group_vector::iterator g = groups.begin(); g != groups.end(); ++g) {
+    if ((*g)->empty()) {
+      prev->next = (*g)->next;
+      if ((*g)->index_entry)
+        *(*g)->index_entry = 0;
+      (*g)->destroy();
+    }
+    else {
+      prev = *out++ = *g;
+    }
+  }
+  groups.erase(out, groups.end());
+}
+
+} } }
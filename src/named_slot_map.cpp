@@ -13,6 +13,7 @@
 #include <cassert>
 #include <map>
 #include <list>
+#include <new>
 #include <typeinfo>
 
 namespace boost { namespace BOOST_SIGNALS_NAMESPACE { namespace detail {
@@ -29,6 +30,17 @@ void named_slot_map_iterator::decrement() { assert(false); }
 void named_slot_map_iterator::advance(difference_type) { assert(false); }
 #endif
 
+slot_map_base::~slot_map_base() { }
+
+void slot_map_base::insert_slots(const stored_group& name,
+                                 connect_position at, slot_source& source)
+{
+  const connection* con;
+  const void* slot;
+  while (source.next(con, slot))
+    source.inserted(insert_slot(name, *con, slot, at));
+}
+
 named_slot_map::named_slot_map(const compare_type& compare) : groups(compare)
 {
   clear();
@@ -53,9 +65,8 @@ named_slot_map::iterator named_slot_map::end()
   return named_slot_map::iterator(groups.end(), groups.end());
 }
 
-named_slot_map::iterator
-named_slot_map::insert(const stored_group& name, const connection& con,
-                       const any& slot, connect_position at)
+named_slot_map::group_iterator
+named_slot_map::insertion_group(const stored_group& name, connect_position at)
 {
   group_iterator group;
   if (name.empty()) {
@@ -70,6 +81,20 @@ named_slot_map::insert(const stored_group& name, const connection& con,
       group = groups.insert(v).first;
     }
   }
+  return group;
+}
+
+named_slot_map::iterator
+named_slot_map::insert(const stored_group& name, const connection& con,
+                       const any& slot, connect_position at)
+{
+  return insert_into(insertion_group(name, at), con, slot, at);
+}
+
+named_slot_map::iterator
+named_slot_map::insert_into(group_iterator group, const connection& con,
+                            const any& slot, connect_position at)
+{
   iterator it;
   it.group = group;
   it.last_group = groups.end();
@@ -91,26 +116,13 @@ named_slot_map::insert(const stored_group& name, const connection& con,
   return it;
 }
 
-void named_slot_map::disconnect(const stored_group& name)
-{
-  group_iterator group = groups.find(name);
-  if (group != groups.end()) {
-    slot_pair_iterator i = group->second.begin();
-    while (i != group->second.end()) {
-      slot_pair_iterator next = i;
-      ++next;
-      i->first.disconnect();
-      i = next;
-    }
-    groups.erase((const_group_iterator) group);
-  }
-}
-
 void named_slot_map::erase(iterator pos)
 {
-  // Erase the slot
+  // Erase the slot, and its group once it is empty
   pos.slot_->first.disconnect();
   pos.group->second.erase(pos.slot_);
+  if (empty(pos.group))
+    groups.erase((const_group_iterator) pos.group);
 }
 
 void named_slot_map::remove_disconnected_slots()
@@ -130,5 +142,108 @@ void named_slot_map::remove_disconnected_slots()
   }
 }
 
+namespace {
+  // Whether the position of a slot fits inside its basic_connection
+  const bool position_fits =
+    sizeof(named_slot_map::iterator)
+      <= sizeof(basic_connection::slot_position_type);
+} // end anonymous namespace
+
+void*
+named_slot_map::store_slot(const stored_group& name, const connection& con,
+                           const any& slot, connect_position at)
+{
+  return store_position(con, slot, at, insertion_group(name, at));
+}
+
+void named_slot_map::store_slots(const stored_group& name,
+                                 connect_position at, slot_source& source,
+                                 any (*wrap)(const void*))
+{
+  group_iterator group = insertion_group(name, at);
+  try {
+    const connection* con;
+    const void* slot;
+    while (source.next(con, slot))
+      source.inserted(store_position(*con, wrap(slot), at, group));
+  }
+  catch(...) {
+    if (empty(group))
+      groups.erase((const_group_iterator) group);
+    throw;
+  }
+
+  if (empty(group))
+    groups.erase((const_group_iterator) group);
+}
+
+void*
+named_slot_map::store_position(const connection& con, const any& slot,
+                               connect_position at, group_iterator group)
+{
+  // Make room for an iterator that will hold the point of insertion of
+  // the slot into the list. This is used to later remove the slot when it
+  // is disconnected. The connection has space set aside for it, so it
+  // need not be allocated.
+  iterator* saved_iter;
+  if (position_fits)
+    saved_iter =
+      new (con.get_connection()->slot_position.address()) iterator;
+  else
+    saved_iter = new iterator;
+
+  // The assignment operation here absolutely must not throw, which
+  // intuitively makes sense (because any container's insert method
+  // becomes impossible to use in an exception-safe manner without this
+  // assumption), but doesn't appear to be mentioned in the standard.
+  try {
+    *saved_iter = insert_into(group, con, slot, at);
+  }
+  catch(...) {
+    release_position(saved_iter);
+    throw;
+  }
+
+  // Make the copy of the connection in the list disconnect when it is
+  // destroyed.
+  (*saved_iter)->first.set_controlling();
+  return saved_iter;
+}
+
+void named_slot_map::erase_slot(void* position)
+{
+  erase(*static_cast<iterator*>(position));
+}
+
+void named_slot_map::release_position(void* position)
+{
+  iterator* saved_iter = static_cast<iterator*>(position);
+  if (position_fits)
+    saved_iter->~named_slot_map_iterator();
+  else
+    delete saved_iter;
+}
+
+void named_slot_map::group_connections(const stored_group& name,
+                                       std::vector<connection>& out)
+{
+  group_iterator group = groups.find(name);
+  if (group == groups.end())
+    return;
+
+  for (slot_pair_iterator i = group->second.begin();
+       i != group->second.end(); ++i) {
+    out.push_back(i->first);
+    out.back().set_controlling(false);
+  }
+}
+
+void named_slot_map::connections(std::vector<connection>& out)
+{
+  for (iterator i = begin(); i != end(); ++i) {
+    out.push_back(i->first);
+    out.back().set_controlling(false);
+  }
+}
 
 } } }
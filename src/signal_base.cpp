@@ -10,38 +10,150 @@
 #define BOOST_SIGNALS_SOURCE
 
 #include <boost/signals/detail/signal_base.hpp>
+#include <algorithm>
 #include <cassert>
 
 namespace boost {
   namespace BOOST_SIGNALS_NAMESPACE {
     namespace detail {
-      signal_base_impl::signal_base_impl(const compare_type& comp,
-                                         const any& combiner)
+      namespace {
+        // Holds the lock of a signal, if it has one
+        class exclusive_lock {
+        public:
+          exclusive_lock(signal_lock* l) : lock(l)
+          {
+            if (lock) lock->lock();
+          }
+
+          ~exclusive_lock()
+          {
+            if (lock) lock->unlock();
+          }
+
+        private:
+          signal_lock* lock;
+        };
+
+        // Holds the lock of a signal shared, if it has one
+        class shared_lock {
+        public:
+          shared_lock(signal_lock* l) : lock(l)
+          {
+            if (lock) lock->lock_shared();
+          }
+
+          ~shared_lock()
+          {
+            if (lock) lock->unlock_shared();
+          }
+
+        private:
+          signal_lock* lock;
+        };
+
+        // Hands the slots of a sequence to the slot container, and makes
+        // the connection of each slot refer to the signal once the slot
+        // has been inserted
+        class connecting_source : public slot_source {
+        public:
+          connecting_source(signal_base_impl* s, slot_sequence& seq,
+                            std::vector<connection>& c)
+            : signal(s), slots(seq), connections(c), current(0)
+          {
+          }
+
+          bool next(const connection*& con, const void*& slot)
+          {
+            const void* f;
+            slot_base::data_t* data;
+            while (slots.next(f, data)) {
+              connections.push_back(connection());
+              connection& c = data->watch_bound_objects;
+              if (!c.connected())
+                continue;
+
+              // As in connect_slot, the slot container takes over the
+              // ownership of the connection
+              c.set_controlling(false);
+              current = &c;
+              con = current;
+              slot = f;
+              return true;
+            }
+            return false;
+          }
+
+          void inserted(void* position)
+          {
+            basic_connection* con = current->get_connection().get();
+            con->signal = signal;
+            con->signal_data = position;
+            con->signal_disconnect = &signal_base_impl::slot_disconnected;
+            ++signal->connected_slots;
+            connections.back() = *current;
+            current = 0;
+          }
+
+          // Disconnect the slot that was provided but not inserted, if
+          // any. It does not refer to the signal yet.
+          void abandon()
+          {
+            if (current)
+              current->disconnect();
+          }
+
+        private:
+          signal_base_impl* signal;
+          slot_sequence& slots;
+          std::vector<connection>& connections;
+          connection* current;
+        };
+      } // end anonymous namespace
+
+      signal_lock::~signal_lock() {}
+
+      signal_base_impl::signal_base_impl(const void* group_compare,
+                                         const any& combiner,
+                                         slot_map_factory create_slots,
+                                         signal_lock_factory create_lock)
         : call_depth(0),
-          slots_(comp),
+          connected_slots(0),
+          batch_depth(0),
+          clearing(false),
+          lock_(create_lock()),
+          slots_(create_slots(group_compare)),
           combiner_(combiner)
       {
         flags.delayed_disconnect = false;
-        flags.clearing = false;
       }
 
       signal_base_impl::~signal_base_impl()
       {
         // Set the "clearing" flag to ignore extraneous disconnect requests,
         // because all slots will be disconnected on destruction anyway.
-        flags.clearing = true;
+        clearing.store(true);
       }
 
       void signal_base_impl::disconnect_all_slots()
       {
         // Do nothing if we're already clearing the slot list
-        if (flags.clearing)
+        if (clearing.load())
           return;
 
-        if (call_depth == 0) {
+        std::vector<connection> slots;
+        if (lock_) {
+          // Disconnecting a slot takes the lock, so only hold it while
+          // gathering the slots
+          {
+            shared_lock lock(lock_.get());
+            slots_->connections(slots);
+          }
+          disconnect_each(slots);
+        }
+        else if (call_depth == 0) {
           // Clearing the slot list will disconnect all slots automatically
           temporarily_set_clearing set_clearing(this);
-          slots_.clear();
+          slots_->clear();
         }
         else {
           // We can't actually remove elements from the slot list because there
@@ -51,15 +163,14 @@ namespace boost {
           // reach zero, the call list will be cleared.
           flags.delayed_disconnect = true;
           temporarily_set_clearing set_clearing(this);
-          for (iterator i = slots_.begin(); i != slots_.end(); ++i) {
-            i->first.disconnect();
-          }
+          slots_->connections(slots);
+          disconnect_each(slots);
         }
       }
 
       connection
       signal_base_impl::
-        connect_slot(const any& slot_,
+        connect_slot(const void* slot_,
                      const stored_group& name,
                      shared_ptr<slot_base::data_t> data,
                      connect_position at)
@@ -69,132 +180,247 @@ namespace boost {
         data->watch_bound_objects.set_controlling(false);
         scoped_connection safe_connection(data->watch_bound_objects);
 
-        // Allocate storage for an iterator that will hold the point of
-        // insertion of the slot into the list. This is used to later remove
-        // the slot when it is disconnected.
-        
-#if defined(BOOST_NO_CXX11_SMART_PTR)
-
-        std::auto_ptr<iterator> saved_iter(new iterator);
-        
-#else
-
-        std::unique_ptr<iterator> saved_iter(new iterator);
-        
-#endif
-
-        // Add the slot to the list.
-        iterator pos =
-          slots_.insert(name, data->watch_bound_objects, slot_, at);
-
-        // The assignment operation here absolutely must not throw, which
-        // intuitively makes sense (because any container's insert method
-        // becomes impossible to use in an exception-safe manner without this
-        // assumption), but doesn't appear to be mentioned in the standard.
-        *saved_iter = pos;
-
-        // Fill out the connection object appropriately. None of these
-        // operations can throw
-        data->watch_bound_objects.get_connection()->signal = this;
-        data->watch_bound_objects.get_connection()->signal_data =
-          saved_iter.release();
-        data->watch_bound_objects.get_connection()->signal_disconnect =
-          &signal_base_impl::slot_disconnected;
-
-        // Make the copy of the connection in the list disconnect when it is
-        // destroyed. The local, scoped connection is then released
-        // because ownership has been transferred.
-        pos->first.set_controlling();
+        exclusive_lock lock(lock_.get());
+
+        // Fill out the connection object before the slot is added to the
+        // list: snapshot storage publishes the slot as soon as it is
+        // inserted, without the lock, so another thread may disconnect it
+        // right away. Such storage identifies a slot by its connection,
+        // which therefore serves as the position until it is known.
+        basic_connection* con =
+          data->watch_bound_objects.get_connection().get();
+        void* const unbound_signal = con->signal;
+        void (*const unbound_disconnect)(void*, void*) =
+          con->signal_disconnect;
+        con->signal = this;
+        con->signal_data = con;
+        con->signal_disconnect = &signal_base_impl::slot_disconnected;
+        ++connected_slots;
+
+        // Add the slot to the list. The slot container keeps the point of
+        // insertion, which is used to later remove the slot when it is
+        // disconnected, and makes its copy of the connection disconnect
+        // when it is destroyed.
+        void* position;
+        try {
+          position =
+            slots_->insert_slot(name, data->watch_bound_objects, slot_, at);
+        }
+        catch(...) {
+          // The slot is not in the list, so the connection must not
+          // disconnect it from this signal
+          --connected_slots;
+          con->signal = unbound_signal;
+          con->signal_data = 0;
+          con->signal_disconnect = unbound_disconnect;
+          throw;
+        }
+
+        // Any other storage is only used under the lock, which is still
+        // held
+        if (position != con)
+          con->signal_data = position;
+
+        // The local, scoped connection is released because ownership has
+        // been transferred.
         return safe_connection.release();
       }
 
+      void signal_base_impl::connect_slots(const stored_group& name,
+                                           connect_position at,
+                                           slot_sequence& slots,
+                                           std::vector<connection>& out)
+      {
+        std::size_t first = out.size();
+        connecting_source source(this, slots, out);
+        try {
+          exclusive_lock lock(lock_.get());
+          slots_->insert_slots(name, at, source);
+        }
+        catch(...) {
+          // Disconnecting a slot takes the lock, which has been released
+          source.abandon();
+          for (std::size_t i = first; i < out.size(); ++i)
+            out[i].disconnect();
+          out.resize(first);
+          throw;
+        }
+      }
+
       bool signal_base_impl::empty() const
       {
         // Disconnected slots may still be in the list of slots if
         //   a) this is called while slots are being invoked (call_depth > 0)
         //   b) an exception was thrown in remove_disconnected_slots
-        for (iterator i = slots_.begin(); i != slots_.end(); ++i) {
-          if (i->first.connected())
-            return false;
+        // so we rely on the count of connected slots instead.
+        return connected_slots == 0;
+      }
+
+      std::size_t signal_base_impl::num_slots() const
+      {
+        return static_cast<long>(connected_slots);
+      }
+
+      void signal_base_impl::disconnect(const stored_group& group)
+      {
+        // Disconnecting a slot may remove it, so gather the slots of the
+        // group first
+        std::vector<connection> slots;
+        {
+          shared_lock lock(lock_.get());
+          slots_->group_connections(group, slots);
         }
+        disconnect_each(slots);
+      }
 
-        return true;
+      bool signal_base_impl::signal_order(const connection& x,
+                                          const connection& y)
+      {
+        const basic_connection* a = x.con.get();
+        const basic_connection* b = y.con.get();
+        if (a->signal_disconnect != b->signal_disconnect)
+          return std::less<void (*)(void*, void*)>()(a->signal_disconnect,
+                                                     b->signal_disconnect);
+        return std::less<void*>()(a->signal, b->signal);
       }
 
-      std::size_t signal_base_impl::num_slots() const
+      void signal_base_impl::disconnect_each(std::vector<connection>& slots)
       {
-        // Disconnected slots may still be in the list of slots if
-        //   a) this is called while slots are being invoked (call_depth > 0)
-        //   b) an exception was thrown in remove_disconnected_slots
-        std::size_t count = 0;
-        for (iterator i = slots_.begin(); i != slots_.end(); ++i) {
-          if (i->first.connected())
-            ++count;
+        typedef std::vector<connection>::iterator iterator;
+
+        if (slots.size() > 1)
+          std::sort(slots.begin(), slots.end(), &signal_order);
+
+        iterator i = slots.begin();
+        while (i != slots.end()) {
+          iterator last = i + 1;
+          while (last != slots.end() && !signal_order(*i, *last))
+            ++last;
+
+          // Disconnecting the slots of one signal may destroy another
+          // signal, which disconnects its slots: a signal is only known
+          // to be alive while one of its connections is connected
+          iterator live = i;
+          while (live != last && !live->connected())
+            ++live;
+
+          if (live != last &&
+              live->con->signal_disconnect == &slot_disconnected &&
+              last - live > 1) {
+            static_cast<signal_base_impl*>(live->con->signal)
+              ->disconnect_batch(live, last);
+          }
+          else {
+            for (; live != last; ++live)
+              live->disconnect();
+          }
+
+          i = last;
         }
-        return count;
       }
 
-      void signal_base_impl::disconnect(const stored_group& group)
-      { slots_.disconnect(group); }
+      void signal_base_impl::disconnect_batch(
+             std::vector<connection>::iterator first,
+             std::vector<connection>::iterator last)
+      {
+        bool batch;
+        {
+          exclusive_lock lock(lock_.get());
+          batch = slots_->prefer_batch_erase(last - first, connected_slots);
+          if (batch)
+            ++batch_depth;
+        }
+
+        if (!batch) {
+          for (; first != last; ++first)
+            first->disconnect();
+          return;
+        }
 
-      void signal_base_impl::slot_disconnected(void* obj, void* data)
+        // Nothing is erased while the slots are disconnected, so this
+        // signal stays alive until the slots are removed below
+        try {
+          for (; first != last; ++first)
+            first->disconnect();
+        }
+        catch(...) {
+          exclusive_lock lock(lock_.get());
+          --batch_depth;
+          throw;
+        }
+
+        exclusive_lock lock(lock_.get());
+        if (--batch_depth == 0 && call_depth == 0 && !clearing.load())
+          slots_->remove_disconnected_slots();
+      }
+
+      void signal_base_impl::slot_disconnected(void* obj, void* con)
       {
         signal_base_impl* self = reinterpret_cast<signal_base_impl*>(obj);
+        exclusive_lock lock(self->lock_.get());
 
-        // We won't need the slot iterator after this
-        
-#if defined(BOOST_NO_CXX11_SMART_PTR)
-
-        std::auto_ptr<iterator> slot(reinterpret_cast<iterator*>(data));
-        
-#else
+        // The slot may have moved since the connection was disconnected,
+        // so look up its position under the lock
+        void* data = static_cast<basic_connection*>(con)->signal_data;
 
-        std::unique_ptr<iterator> slot(reinterpret_cast<iterator*>(data));
-        
-#endif
+        // Every disconnection comes through here exactly once, including
+        // those made while clearing
+        --self->connected_slots;
 
-        // If we're flags.clearing, we don't bother updating the list of slots
-        if (!self->flags.clearing) {
+        // If we're clearing, we don't bother updating the list of slots
+        if (!self->clearing.load()) {
           // If we're in a call, note the fact that a slot has been deleted so
           // we can come back later to remove the iterator
           if (self->call_depth > 0) {
             self->flags.delayed_disconnect = true;
           }
-          else {
+          else if (self->batch_depth == 0) {
             // Just remove the slot now, it's safe
-            self->slots_.erase(*slot);
+            self->slots_->erase_slot(data);
           }
+          // Otherwise the batch of disconnections removes the slot
         }
+
+        // We won't need the slot position after this
+        self->slots_->release_position(data);
       }
 
       void signal_base_impl::remove_disconnected_slots() const
-      { slots_.remove_disconnected_slots(); }
+      { slots_->remove_disconnected_slots(); }
 
       call_notification::
         call_notification(const shared_ptr<signal_base_impl>& b) :
           impl(b)
       {
-        // A call will be made, so increment the call depth as a notification
+        // A call will be made, so increment the call depth as a
+        // notification
+        exclusive_lock lock(impl->lock_.get());
         impl->call_depth++;
       }
 
       call_notification::~call_notification()
       {
+        exclusive_lock lock(impl->lock_.get());
         impl->call_depth--;
 
         // If the call depth is zero and we have some slots that have been
-        // disconnected during the calls, remove those slots from the list
+        // disconnected during the calls, remove those slots from the list,
+        // unless a batch of disconnections will
         if (impl->call_depth == 0 &&
-            impl->flags.delayed_disconnect) {
+            impl->flags.delayed_disconnect &&
+            impl->batch_depth == 0) {
           impl->remove_disconnected_slots();
           impl->flags.delayed_disconnect = false;
         }
       }
 
-    signal_base::signal_base(const compare_type& comp, const any& combiner)
+    signal_base::signal_base(const void* group_compare, const any& combiner,
+                             slot_map_factory create_slots,
+                             signal_lock_factory create_lock)
       : impl()
     {
-      impl.reset(new signal_base_impl(comp, combiner));
+      impl.reset(new signal_base_impl(group_compare, combiner, create_slots,
+                                      create_lock));
     }
 
     signal_base::~signal_base()
@@ -10,50 +10,101 @@
 #define BOOST_SIGNALS_SOURCE
 
 #include <boost/signals/trackable.hpp>
-#include <algorithm>
+#include <boost/signals/detail/signal_base.hpp>
+#include <cstddef>
+#include <new>
+#include <vector>
 
 namespace boost {
   namespace BOOST_SIGNALS_NAMESPACE {
-    void trackable::signal_disconnected(void* obj, void* data)
-    {
-      trackable* self = reinterpret_cast<trackable*>(obj);
-      connection_iterator* signal =
-        reinterpret_cast<connection_iterator*>(data);
-
-      // If we're dying, don't bother erasing the connection from the list;
-      // it'll be gone anyway
-      if (!self->dying) {
-        self->connected_signals.erase(*signal);
+    namespace {
+      void unlink_hook(detail::trackable_hook* hook)
+      {
+        hook->prev->next = hook->next;
+        hook->next->prev = hook->prev;
+        hook->prev = hook->next = 0;
       }
+    }
 
-      // This iterator pointer won't ever be used again
-      delete signal;
+    void trackable::signal_disconnected(void*, void* data)
+    {
+      detail::trackable_hook* hook =
+        reinterpret_cast<detail::trackable_hook*>(data);
+
+      // The object unlinks the connection itself when it disconnects all
+      // of its connections
+      if (hook->linked()) {
+        unlink_hook(hook);
+        intrusive_ptr_release(hook->con);
+      }
     }
 
     void
-    trackable::signal_connected(connection c,
+    trackable::signal_connected(detail::basic_connection* con,
                                 BOOST_SIGNALS_NAMESPACE::detail::bound_object& binding) const
     {
-      // Insert the connection
-      connection_iterator pos =
-        connected_signals.insert(connected_signals.end(), c);
-
-      // Make this copy of the object disconnect when destroyed
-      pos->set_controlling();
+      // Link the connection at the end of the list, keeping it alive for
+      // as long as it is linked
+      detail::trackable_hook* hook = &binding.hook;
+      intrusive_ptr_add_ref(con);
+      hook->con = con;
+      hook->prev = connected_signals.prev;
+      hook->next = &connected_signals;
+      connected_signals.prev->next = hook;
+      connected_signals.prev = hook;
 
       binding.obj = const_cast<void*>(reinterpret_cast<const void*>(this));
-      binding.data = reinterpret_cast<void*>(new connection_iterator(pos));
+      binding.data = reinterpret_cast<void*>(hook);
       binding.disconnect = &signal_disconnected;
     }
 
+    void trackable::disconnect_all()
+    {
+      // The connections take over the references of the list, and are
+      // unlinked before they are disconnected, so that disconnecting does
+      // not come back to this object, which may be in the middle of being
+      // destroyed
+      std::size_t count = 0;
+      for (detail::trackable_hook* hook = connected_signals.next;
+           hook != &connected_signals; hook = hook->next)
+        ++count;
+
+      // Disconnect the connections of each signal together, so that the
+      // signal removes their slots in one pass. If there is no memory for
+      // that, disconnect them one at a time.
+      std::vector<connection> signals;
+      if (count > 1) {
+        try {
+          signals.resize(count);
+        }
+        catch(std::bad_alloc&) {
+        }
+      }
+
+      if (signals.empty()) {
+        while (connected_signals.next != &connected_signals) {
+          detail::trackable_hook* hook = connected_signals.next;
+          connection c;
+          c.con = intrusive_ptr<detail::basic_connection>(hook->con, false);
+          unlink_hook(hook);
+          c.disconnect();
+        }
+        return;
+      }
+
+      for (std::vector<connection>::iterator c = signals.begin();
+           c != signals.end(); ++c) {
+        detail::trackable_hook* hook = connected_signals.next;
+        c->con = intrusive_ptr<detail::basic_connection>(hook->con, false);
+        unlink_hook(hook);
+      }
+
+      detail::signal_base_impl::disconnect_each(signals);
+    }
+
     trackable::~trackable()
     {
-      dying = true;
+      disconnect_all();
     }
   } // end namespace BOOST_SIGNALS_NAMESPACE
 }
-
-#ifndef BOOST_MSVC
-// Explicit instantiations to keep in the library
-template class std::list<boost::BOOST_SIGNALS_NAMESPACE::connection>;
-#endif
@@ -0,0 +1,184 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/bind.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+static long allocations;
+static long live_allocations;
+static long global_allocations;
+
+// Frees a block of the operators below. GCC must not see it inlined into
+// operator delete, or it would warn about freeing what operator new
+// returned.
+BOOST_NOINLINE static void free_block(void* p)
+{
+  std::free(p);
+}
+
+// Counts the calls of the global operator new, which the counting
+// allocator below does not use
+void* operator new(std::size_t size)
+{
+  ++global_allocations;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) BOOST_NOEXCEPT
+{
+  free_block(p);
+}
+
+void operator delete(void* p, std::size_t) BOOST_NOEXCEPT
+{
+  free_block(p);
+}
+
+// Counts the blocks it allocates, and those that have not been freed yet
+template<typename T>
+struct counting_allocator : std::allocator<T> {
+  template<typename U> struct rebind { typedef counting_allocator<U> other; };
+
+  counting_allocator() {}
+
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) {}
+
+  T* allocate(std::size_t n, const void* = 0)
+  {
+    ++allocations;
+    ++live_allocations;
+    if (void* p = std::malloc(n * sizeof(T)))
+      return static_cast<T*>(p);
+    throw std::bad_alloc();
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    --live_allocations;
+    std::free(p);
+  }
+};
+
+template<>
+struct counting_allocator<void> : std::allocator<void> {
+  template<typename U> struct rebind { typedef counting_allocator<U> other; };
+
+  counting_allocator() {}
+
+  template<typename U>
+  counting_allocator(const counting_allocator<U>&) {}
+};
+
+template<typename T, typename U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&)
+{ return true; }
+
+template<typename T, typename U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&)
+{ return false; }
+
+struct make_int {
+  make_int(int v) : value(v) {}
+  int operator()() const { return value; }
+  int value;
+};
+
+struct tracked : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
+  int get() const { return 7; }
+};
+
+template<typename SlotStorage>
+void test_allocator()
+{
+  typedef boost::signal<int (), boost::last_value<int>, int, std::less<int>,
+                        boost::function<int ()>, SlotStorage,
+                        boost::BOOST_SIGNALS_NAMESPACE::null_lock,
+                        counting_allocator<void> > signal_type;
+
+  allocations = live_allocations = 0;
+  {
+    signal_type sig;
+
+    // Each slot allocates at least its tracking data and its connection
+    long before = allocations;
+    boost::BOOST_SIGNALS_NAMESPACE::connection c =
+      sig.connect(make_int(1), boost::BOOST_SIGNALS_NAMESPACE::at_front);
+    BOOST_CHECK(allocations >= before + 2);
+
+    sig.connect(2, make_int(2));
+    sig.connect(1, make_int(3));
+    BOOST_CHECK(sig() == 2);
+
+    {
+      tracked t;
+      sig.connect(3, boost::bind(&tracked::get, &t));
+      BOOST_CHECK(sig() == 7);
+    }
+    BOOST_CHECK(sig() == 2);
+    BOOST_CHECK(sig.num_slots() == 3);
+
+    sig.disconnect(2);
+    BOOST_CHECK(sig() == 3);
+    c.disconnect();
+    BOOST_CHECK(sig.num_slots() == 1);
+  }
+
+  // Everything the signal allocated has been freed
+  BOOST_CHECK(live_allocations == 0);
+}
+
+// With flat slot storage, everything that connecting slots allocates
+// comes from the allocator of the signal, including the vector of groups
+static void test_group_allocation()
+{
+  typedef boost::signal<int (), boost::last_value<int>, int, std::less<int>,
+                        boost::function<int ()>,
+                        boost::BOOST_SIGNALS_NAMESPACE::flat_slot_storage,
+                        boost::BOOST_SIGNALS_NAMESPACE::null_lock,
+                        counting_allocator<void> > signal_type;
+
+  allocations = live_allocations = 0;
+  {
+    signal_type sig;
+    long before = global_allocations;
+
+    // Groups both inside and outside of the range that is indexed
+    // directly, each of them new
+    for (int i = 0; i < 40; ++i) {
+      sig.connect(i * 7, make_int(i));
+      sig.connect(-1000 - i, make_int(i));
+    }
+    sig.connect(make_int(0));
+    BOOST_CHECK(sig.num_slots() == 81);
+    BOOST_CHECK(global_allocations == before);
+    BOOST_CHECK(allocations > 0);
+  }
+  BOOST_CHECK(live_allocations == 0);
+}
+
+int test_main(int, char* [])
+{
+  using boost::BOOST_SIGNALS_NAMESPACE::flat_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::node_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::snapshot_slot_storage;
+
+  test_allocator<flat_slot_storage>();
+  test_allocator<node_slot_storage>();
+  test_allocator<snapshot_slot_storage>();
+  test_group_allocation();
+  return 0;
+}
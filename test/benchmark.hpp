@@ -0,0 +1,89 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+// Timing and reporting shared by the benchmarks. Each measurement is
+// written as one line of comma-separated values:
+//
+//   benchmark,case,slots,metric,value
+//
+// to the file named on the command line, or to standard output, so that
+// the results of different builds can be compared mechanically.
+
+#ifndef BOOST_SIGNALS_TEST_BENCHMARK_HPP
+#define BOOST_SIGNALS_TEST_BENCHMARK_HPP
+
+#include <boost/chrono.hpp>
+#include <boost/noncopyable.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace benchmark {
+
+class report : boost::noncopyable {
+public:
+  report(const char* benchmark, int argc, char* argv[])
+    : name(benchmark), out(&std::cout)
+  {
+    if (argc > 1) {
+      file.open(argv[1]);
+      out = &file;
+    }
+    *out << "benchmark,case,slots,metric,value\n";
+  }
+
+  bool good() const { return out->good(); }
+
+  void add(const std::string& test_case, int slots, const char* metric,
+           double value)
+  {
+    *out << name << ',' << test_case << ',' << slots << ',' << metric
+         << ',' << value << '\n';
+    out->flush();
+  }
+
+private:
+  std::string name;
+  std::ofstream file;
+  std::ostream* out;
+};
+
+// The number of iterations that makes a measurement last long enough to
+// be meaningful, when each iteration does work proportional to the
+// number of slots
+inline long iterations_for(int slots)
+{
+  long iterations = (1L << 22) / (slots + 1);
+  return iterations < 1000? 1000 : iterations;
+}
+
+// Runs the function object the given number of times, after running it
+// for a tenth of that to warm up, and returns the average time taken in
+// nanoseconds
+template<typename F>
+double ns_per_iteration(F& f, long iterations)
+{
+  typedef boost::chrono::steady_clock clock;
+
+  for (long i = 0; i < iterations / 10; ++i)
+    f();
+
+  clock::time_point start = clock::now();
+  for (long i = 0; i < iterations; ++i)
+    f();
+  clock::duration elapsed = clock::now() - start;
+
+  return static_cast<double>(
+           boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed)
+             .count()) / iterations;
+}
+
+} // end namespace benchmark
+
+#endif // BOOST_SIGNALS_TEST_BENCHMARK_HPP
@@ -0,0 +1,180 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+// Measures the life cycle of trackable objects that connect slots: each
+// session connects a slot bound to itself to each of several signals, or
+// several slots to a single signal, and is then destroyed, which
+// disconnects its slots. Reports the time
+// per session, the connections made per second, the number of
+// allocations per connection and the peak memory per live session.
+// Usage:
+//
+//   churn_benchmark [results.csv]
+
+#include <boost/signal.hpp>
+#include <boost/bind.hpp>
+#include <boost/config.hpp>
+#include <boost/scoped_array.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "benchmark.hpp"
+
+// Allocation accounting. Every allocation is preceded by a header that
+// records its size.
+namespace {
+  const std::size_t header_size = 16;
+
+  std::size_t allocations;
+  std::size_t live_bytes;
+  std::size_t peak_bytes;
+}
+
+void* operator new(std::size_t size)
+{
+  char* p = static_cast<char*>(std::malloc(size + header_size));
+  if (!p)
+    throw std::bad_alloc();
+
+  *reinterpret_cast<std::size_t*>(p) = size;
+  ++allocations;
+  live_bytes += size;
+  if (live_bytes > peak_bytes)
+    peak_bytes = live_bytes;
+  return p + header_size;
+}
+
+void operator delete(void* ptr) BOOST_NOEXCEPT
+{
+  if (!ptr)
+    return;
+
+  char* p = static_cast<char*>(ptr) - header_size;
+  live_bytes -= *reinterpret_cast<std::size_t*>(p);
+  std::free(p);
+}
+
+// Called instead of the above when the compiler uses sized deallocation;
+// the header already records the size
+void operator delete(void* ptr, std::size_t) BOOST_NOEXCEPT
+{
+  operator delete(ptr);
+}
+
+static const int slot_counts[] = { 1, 4, 16, 200 };
+
+// The number of sessions that are alive at once in the batched case
+static const int batch_size = 1000;
+
+typedef boost::signal<void (int)> signal_type;
+
+static long events;
+
+class session : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
+public:
+  // Connects to the given number of signals, or that many times to the
+  // first signal if the session has a single signal
+  session(signal_type* signals, int count, bool single_signal = false)
+  {
+    for (int i = 0; i < count; ++i)
+      signals[single_signal? 0 : i].connect(
+        boost::bind(&session::on_event, this, _1));
+  }
+
+  void on_event(int n) { events += n; }
+};
+
+// Creates and destroys one session at a time
+struct one_at_a_time {
+  one_at_a_time(signal_type* s, int c) : signals(s), count(c) {}
+
+  void operator()() { session s(signals, count); }
+
+  static int sessions() { return 1; }
+
+  signal_type* signals;
+  int count;
+};
+
+// Creates a batch of sessions, then destroys them all
+struct batched {
+  batched(signal_type* s, int c) : signals(s), count(c) {}
+
+  void operator()()
+  {
+    std::vector<session*> live;
+    live.reserve(batch_size);
+    for (int i = 0; i < batch_size; ++i)
+      live.push_back(new session(signals, count));
+    for (int i = 0; i < batch_size; ++i)
+      delete live[i];
+  }
+
+  static int sessions() { return batch_size; }
+
+  signal_type* signals;
+  int count;
+};
+
+// Creates and destroys one session at a time, which connects all of its
+// slots to the same signal
+struct single_signal {
+  single_signal(signal_type* s, int c) : signals(s), count(c) {}
+
+  void operator()() { session s(signals, count, true); }
+
+  static int sessions() { return 1; }
+
+  signal_type* signals;
+  int count;
+};
+
+template<typename Churn>
+void run(benchmark::report& report, const char* name)
+{
+  for (std::size_t i = 0; i < sizeof(slot_counts)/sizeof(int); ++i) {
+    int slots = slot_counts[i];
+    boost::scoped_array<signal_type> signals(new signal_type[slots]);
+    Churn churn(signals.get(), slots);
+
+    long iterations = (1L << 18) / (Churn::sessions() * slots);
+    if (iterations < 10)
+      iterations = 10;
+    double ns_per_session =
+      benchmark::ns_per_iteration(churn, iterations) / Churn::sessions();
+
+    // Count the allocations and the peak memory of a single run
+    std::size_t allocations_before = allocations;
+    peak_bytes = live_bytes;
+    std::size_t bytes_before = live_bytes;
+    churn();
+    double connections = static_cast<double>(Churn::sessions()) * slots;
+
+    report.add(name, slots, "ns_per_session", ns_per_session);
+    report.add(name, slots, "connections_per_second",
+               1e9 * slots / ns_per_session);
+    report.add(name, slots, "allocations_per_connection",
+               (allocations - allocations_before) / connections);
+    report.add(name, slots, "peak_bytes_per_session",
+               static_cast<double>(peak_bytes - bytes_before)
+                 / Churn::sessions());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  benchmark::report report("churn", argc, argv);
+
+  run<one_at_a_time>(report, "one_at_a_time");
+  run<batched>(report, "batched");
+  run<single_signal>(report, "single_signal");
+
+  return report.good()? 0 : 1;
+}
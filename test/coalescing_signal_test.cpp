@@ -0,0 +1,218 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signals/coalescing_signal.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace signals = boost::BOOST_SIGNALS_NAMESPACE;
+
+static std::vector<std::pair<int, double> > received;
+
+struct record {
+  void operator()(int id, double value) const
+  {
+    if (value < 0)
+      throw std::runtime_error("negative");
+    received.push_back(std::make_pair(id, value));
+  }
+};
+
+static int calls;
+
+struct count_call {
+  void operator()() const { ++calls; }
+};
+
+// Counts how its copies are made
+struct counted {
+  static int constructed;
+  static int assigned;
+
+  counted() { ++constructed; }
+  counted(const counted&) { ++constructed; }
+  counted& operator=(const counted&) { ++assigned; return *this; }
+};
+
+int counted::constructed = 0;
+int counted::assigned = 0;
+
+struct take_counted {
+  void operator()(int, const counted&) const { ++calls; }
+};
+
+static void
+test_first_argument()
+{
+  signals::coalescing_signal<void (int, double)> sig;
+  sig.connect(record());
+
+  // Only the latest call with each first argument is delivered, in the
+  // order in which the first arguments were first seen
+  received.clear();
+  sig.post(1, 1.0);
+  sig.post(2, 2.0);
+  sig.post(1, 3.0);
+  sig.post(3, 4.0);
+  sig.post(2, 5.0);
+  BOOST_CHECK(received.empty());
+  BOOST_CHECK(sig.num_pending() == 3);
+  BOOST_CHECK(sig.flush() == 3);
+  BOOST_CHECK(received.size() == 3);
+  BOOST_CHECK(received[0] == std::make_pair(1, 3.0));
+  BOOST_CHECK(received[1] == std::make_pair(2, 5.0));
+  BOOST_CHECK(received[2] == std::make_pair(3, 4.0));
+  BOOST_CHECK(sig.num_pending() == 0);
+  BOOST_CHECK(sig.flush() == 0);
+
+  // Calling the signal directly is not affected
+  sig(4, 6.0);
+  BOOST_CHECK(received.size() == 4);
+}
+
+static void
+test_keys()
+{
+  // A signal without arguments, whose calls all coalesce
+  signals::coalescing_signal<void ()> none;
+  none.connect(count_call());
+  calls = 0;
+  none.post();
+  none.post();
+  none.post();
+  BOOST_CHECK(none.flush() == 1);
+  BOOST_CHECK(calls == 1);
+
+  // Only the latest value matters
+  signals::coalescing_signal<void (int, double), signals::single_key> last;
+  last.connect(record());
+  received.clear();
+  last.post(1, 1.0);
+  last.post(2, 2.0);
+  BOOST_CHECK(last.flush() == 1);
+  BOOST_CHECK(received.size() == 1);
+  BOOST_CHECK(received[0] == std::make_pair(2, 2.0));
+
+  // Keys that are not the first argument
+  signals::coalescing_signal<void (int, double), std::string> named;
+  named.connect(record());
+  received.clear();
+  named.post_with_key("a", 1, 1.0);
+  named.post_with_key("b", 2, 2.0);
+  named.post_with_key("a", 3, 3.0);
+  BOOST_CHECK(named.flush() == 2);
+  BOOST_CHECK(received.size() == 2);
+  BOOST_CHECK(received[0] == std::make_pair(3, 3.0));
+  BOOST_CHECK(received[1] == std::make_pair(2, 2.0));
+}
+
+static void
+test_reuse()
+{
+  signals::coalescing_signal<void (int, const counted&)> sig;
+  sig.connect(take_counted());
+
+  counted c;
+  counted::constructed = counted::assigned = 0;
+  sig.post(1, c);
+  sig.post(2, c);
+  sig.post(1, c);
+  BOOST_CHECK(counted::assigned == 1);
+  sig.flush();
+
+  // Calls recorded after a flush are stored in place of earlier ones
+  sig.post(3, c);
+  sig.post(4, c);
+  sig.flush();
+  sig.post(5, c);
+  sig.post(6, c);
+  int constructed = counted::constructed;
+  sig.flush();
+  sig.post(7, c);
+  sig.post(8, c);
+  BOOST_CHECK(counted::constructed == constructed);
+  calls = 0;
+  BOOST_CHECK(sig.flush() == 2);
+  BOOST_CHECK(calls == 2);
+}
+
+struct post_again {
+  explicit post_again(signals::coalescing_signal<void (int, double)>& s)
+    : sig(&s)
+  {
+  }
+
+  void operator()(int id, double value) const
+  {
+    if (value < 10)
+      sig->post(id, value + 10);
+  }
+
+  signals::coalescing_signal<void (int, double)>* sig;
+};
+
+static void
+test_post_from_slot()
+{
+  signals::coalescing_signal<void (int, double)> sig;
+  sig.connect(post_again(sig));
+  sig.connect(record());
+
+  // Calls recorded by the slots are delivered by the next flush
+  received.clear();
+  sig.post(1, 1.0);
+  BOOST_CHECK(sig.flush() == 1);
+  BOOST_CHECK(sig.num_pending() == 1);
+  BOOST_CHECK(sig.flush() == 1);
+  BOOST_CHECK(received.size() == 2);
+  BOOST_CHECK(received[1] == std::make_pair(1, 11.0));
+}
+
+static void
+test_exception()
+{
+  signals::coalescing_signal<void (int, double), int, boost::last_value<void>,
+                             int, std::less<int>,
+                             boost::function<void (int, double)>,
+                             signals::flat_slot_storage,
+                             signals::spin_lock> sig;
+  sig.connect(record());
+
+  received.clear();
+  sig.post(1, 1.0);
+  sig.post(2, -1.0);
+  sig.post(3, 3.0);
+  bool threw = false;
+  try {
+    sig.flush();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  BOOST_CHECK(threw);
+  BOOST_CHECK(received.size() == 1);
+
+  // The calls after the one that threw are dropped
+  BOOST_CHECK(sig.flush() == 0);
+  sig.post(4, 4.0);
+  BOOST_CHECK(sig.flush() == 1);
+  BOOST_CHECK(received.size() == 2);
+}
+
+int test_main(int, char* [])
+{
+  test_first_argument();
+  test_keys();
+  test_reuse();
+  test_post_from_slot();
+  test_exception();
+  return 0;
+}
@@ -0,0 +1,234 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/signals/combiners.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace signals = boost::BOOST_SIGNALS_NAMESPACE;
+
+static int calls;
+
+// Returns the given value, counting the calls
+struct return_value {
+  return_value(int v) : value(v) {}
+  int operator()() const { ++calls; return value; }
+  int value;
+};
+
+struct return_pointer {
+  return_pointer(const int* p) : pointer(p) {}
+  const int* operator()() const { ++calls; return pointer; }
+  const int* pointer;
+};
+
+template<typename Signal>
+void connect_values(Signal& sig, const int* first, const int* last)
+{
+  for (; first != last; ++first)
+    sig.connect(return_value(*first));
+}
+
+static void
+test_first_non_null()
+{
+  int x = 1, y = 2;
+  boost::signal<const int* (), signals::first_non_null<const int*> > sig;
+  BOOST_CHECK(sig() == 0);
+
+  sig.connect(return_pointer(0));
+  sig.connect(return_pointer(&x));
+  sig.connect(return_pointer(&y));
+  calls = 0;
+  BOOST_CHECK(sig() == &x);
+  BOOST_CHECK(calls == 2);
+}
+
+static void
+test_any_all()
+{
+  static const int values[] = { 1, 1, 0, 1, 0 };
+
+  boost::signal<int (), signals::any_true> any;
+  BOOST_CHECK(!any());
+  any.connect(return_value(0));
+  any.connect(return_value(0));
+  BOOST_CHECK(!any());
+  connect_values(any, values, values + 5);
+  calls = 0;
+  BOOST_CHECK(any());
+  BOOST_CHECK(calls == 3);
+
+  boost::signal<int (), signals::all_true> all;
+  BOOST_CHECK(all());
+  connect_values(all, values, values + 5);
+  calls = 0;
+  BOOST_CHECK(!all());
+  BOOST_CHECK(calls == 3);
+}
+
+static void
+test_first_n()
+{
+  static const int values[] = { 5, 3, 8, 1 };
+
+  typedef boost::signal<int (), signals::first_n<int> > signal_type;
+  signal_type sig(signals::first_n<int>(2));
+  connect_values(sig, values, values + 4);
+  calls = 0;
+  std::vector<int> results = sig();
+  BOOST_CHECK(results.size() == 2);
+  BOOST_CHECK(results[0] == 5 && results[1] == 3);
+  BOOST_CHECK(calls == 2);
+
+  sig.combiner().count = 10;
+  BOOST_CHECK(sig().size() == 4);
+}
+
+static void
+test_arithmetic()
+{
+  static const int values[] = { 5, 3, 8, 1 };
+
+  boost::signal<int (), signals::minimum<int> > smallest;
+  boost::signal<int (), signals::maximum<int> > largest;
+  boost::signal<int (), signals::sum<int> > total;
+  BOOST_CHECK(smallest() == 0);
+  BOOST_CHECK(largest() == 0);
+  BOOST_CHECK(total() == 0);
+
+  connect_values(smallest, values, values + 4);
+  connect_values(largest, values, values + 4);
+  connect_values(total, values, values + 4);
+  BOOST_CHECK(smallest() == 1);
+  BOOST_CHECK(largest() == 8);
+  BOOST_CHECK(total() == 17);
+}
+
+static void
+test_collect_into()
+{
+  static const int values[] = { 5, 3, 8 };
+
+  std::vector<int> results;
+  results.reserve(16);
+  typedef signals::collect_into<std::vector<int> > collect;
+  boost::signal<int (), collect> sig((collect(results)));
+  connect_values(sig, values, values + 3);
+
+  BOOST_CHECK(&sig() == &results);
+  BOOST_CHECK(results.size() == 3);
+  BOOST_CHECK(results[0] == 5 && results[1] == 3 && results[2] == 8);
+  const int* storage = &results[0];
+
+  // The results replace those of the previous call, in the same storage
+  sig();
+  BOOST_CHECK(results.size() == 3);
+  BOOST_CHECK(&results[0] == storage);
+}
+
+static void
+test_buffered()
+{
+  // Enough results for the reductions to use all of their accumulators,
+  // and some left over
+  static const int values[] = { 5, 3, 8, 1, 9, -2, 7, 9, 4, 0, 6 };
+  const int n = sizeof(values) / sizeof(int);
+
+  boost::signal<int (), signals::buffered_sum<int> > total;
+  boost::signal<int (), signals::buffered_minimum<int> > smallest;
+  boost::signal<int (), signals::buffered_maximum<int> > largest;
+  boost::signal<int (), signals::buffered_argmax<int> > largest_at;
+  BOOST_CHECK(total() == 0);
+  BOOST_CHECK(smallest() == 0);
+  BOOST_CHECK(largest() == 0);
+  BOOST_CHECK(largest_at() == 0);
+
+  for (int i = 1; i <= n; ++i) {
+    total.connect(return_value(values[i - 1]));
+    smallest.connect(return_value(values[i - 1]));
+    largest.connect(return_value(values[i - 1]));
+    largest_at.connect(return_value(values[i - 1]));
+
+    int expected_total = 0, expected_smallest = values[0];
+    int expected_largest = values[0];
+    std::size_t expected_at = 0;
+    for (int j = 0; j < i; ++j) {
+      expected_total += values[j];
+      if (values[j] < expected_smallest)
+        expected_smallest = values[j];
+      if (expected_largest < values[j]) {
+        expected_largest = values[j];
+        expected_at = j;
+      }
+    }
+    BOOST_CHECK(total() == expected_total);
+    BOOST_CHECK(smallest() == expected_smallest);
+    BOOST_CHECK(largest() == expected_largest);
+    BOOST_CHECK(largest_at() == expected_at);
+  }
+
+  // Blocked slots are not counted
+  boost::BOOST_SIGNALS_NAMESPACE::connection c =
+    largest_at.connect(return_value(100), signals::at_front);
+  BOOST_CHECK(largest_at() == 0);
+  c.block();
+  BOOST_CHECK(largest_at() == 4);
+}
+
+typedef boost::signal<int (), signals::buffered_sum<int> > buffered_signal;
+
+static bool reentered;
+static int nested_total;
+
+// Calls the signal again, once, from within the outer call
+struct call_again {
+  explicit call_again(buffered_signal& s) : sig(&s) {}
+
+  int operator()() const
+  {
+    if (!reentered) {
+      reentered = true;
+      nested_total = (*sig)();
+    }
+    return 10;
+  }
+
+  buffered_signal* sig;
+};
+
+static void
+test_buffered_reentry()
+{
+  buffered_signal total;
+  total.connect(return_value(1));
+  total.connect(return_value(2));
+  total.connect(call_again(total));
+  total.connect(return_value(4));
+
+  // The nested call does not disturb the results of the outer one
+  reentered = false;
+  BOOST_CHECK(total() == 17);
+  BOOST_CHECK(nested_total == 17);
+  BOOST_CHECK(total() == 17);
+}
+
+int test_main(int, char* [])
+{
+  test_first_non_null();
+  test_any_all();
+  test_first_n();
+  test_arithmetic();
+  test_collect_into();
+  test_buffered();
+  test_buffered_reentry();
+  return 0;
+}
@@ -0,0 +1,259 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/signals/mutex_lock.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/bind.hpp>
+
+namespace signals = boost::BOOST_SIGNALS_NAMESPACE;
+
+template<typename SlotStorage, typename LockPolicy = signals::null_lock>
+struct concurrent_signal {
+  typedef boost::signal<void (int), boost::last_value<void>, int,
+                        std::less<int>, boost::function<void (int)>,
+                        SlotStorage, LockPolicy> type;
+};
+
+// The counts are kept small enough for a single core; define these for
+// longer stress runs
+#ifndef CONCURRENT_SIGNAL_TEST_EMISSIONS
+#  define CONCURRENT_SIGNAL_TEST_EMISSIONS 1000
+#endif
+#ifndef CONCURRENT_SIGNAL_TEST_CHURNS
+#  define CONCURRENT_SIGNAL_TEST_CHURNS 200
+#endif
+
+const int emitters = 4;
+const int emissions = CONCURRENT_SIGNAL_TEST_EMISSIONS;
+const int churns = CONCURRENT_SIGNAL_TEST_CHURNS;
+
+struct counter {
+  counter() : value(0) {}
+
+  void reset()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    value = 0;
+  }
+
+  void add(int n)
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    value += n;
+  }
+
+  long get()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    return value;
+  }
+
+  boost::mutex mutex;
+  long value;
+};
+
+static counter permanent_calls;
+static counter churned_calls;
+
+struct count_permanent {
+  void operator()(int n) const { permanent_calls.add(n); }
+};
+
+struct count_churned {
+  void operator()(int n) const { churned_calls.add(n); }
+};
+
+template<typename Signal>
+static void emit(Signal* sig)
+{
+  for (int i = 0; i < emissions; ++i)
+    (*sig)(1);
+}
+
+template<typename Signal>
+static void churn(Signal* sig)
+{
+  for (int i = 0; i < churns; ++i) {
+    signals::connection c = sig->connect(count_churned());
+    sig->connect(1, count_churned(), signals::at_front);
+    sig->connect(2, count_churned());
+    c.block();
+    c.unblock();
+    c.disconnect();
+    sig->disconnect(1);
+    sig->disconnect(2);
+  }
+}
+
+template<typename Signal>
+static void test_concurrent_calls()
+{
+  permanent_calls.reset();
+  churned_calls.reset();
+
+  Signal sig;
+  sig.connect(0, count_permanent());
+
+  boost::thread churner(boost::bind(&churn<Signal>, &sig));
+
+  boost::thread_group group;
+  for (int i = 0; i < emitters; ++i)
+    group.create_thread(boost::bind(&emit<Signal>, &sig));
+  group.join_all();
+  churner.join();
+
+  // Every call reached the slot that stayed connected throughout, and
+  // every other slot has been disconnected again
+  BOOST_CHECK(permanent_calls.get() == emitters * emissions);
+  BOOST_CHECK(sig.num_slots() == 1);
+
+  long churned = churned_calls.get();
+  sig(1);
+  BOOST_CHECK(permanent_calls.get() == emitters * emissions + 1);
+  BOOST_CHECK(churned_calls.get() == churned);
+}
+
+template<typename Signal>
+static void connect_churned(Signal* sig)
+{
+  for (int i = 0; i < churns; ++i) {
+    sig->connect(count_churned());
+    sig->connect(i % 3, count_churned());
+  }
+}
+
+template<typename Signal>
+static void clear(Signal* sig)
+{
+  for (int i = 0; i < churns; ++i) {
+    sig->disconnect(i % 3);
+    sig->disconnect_all_slots();
+  }
+}
+
+template<typename Signal>
+static void test_concurrent_clears()
+{
+  Signal sig;
+
+  boost::thread connector(boost::bind(&connect_churned<Signal>, &sig));
+  boost::thread clearer(boost::bind(&clear<Signal>, &sig));
+  connector.join();
+  clearer.join();
+
+  // Each slot was counted before it could be disconnected, so clearing
+  // the signal at last leaves it empty
+  sig.disconnect_all_slots();
+  BOOST_CHECK(sig.empty());
+  BOOST_CHECK(sig.num_slots() == 0);
+}
+
+// Uses the signal that is calling it: calls it again, connects another
+// slot, and then disconnects itself
+template<typename Signal>
+struct reentrant_slot {
+  reentrant_slot(Signal* s, signals::connection* c) : sig(s), self(c) {}
+
+  void operator()(int n) const
+  {
+    if (n > 1)
+      return;
+
+    (*sig)(n + 1);
+    sig->connect(count_churned());
+    self->disconnect();
+  }
+
+  Signal* sig;
+  signals::connection* self;
+};
+
+struct tracked : signals::trackable {
+  void call(int) const {}
+};
+
+struct destroy_tracked {
+  explicit destroy_tracked(tracked** t) : object(t) {}
+
+  void operator()(int) const
+  {
+    delete *object;
+    *object = 0;
+  }
+
+  tracked** object;
+};
+
+template<typename Signal>
+static void test_reentrant_slots()
+{
+  permanent_calls.reset();
+
+  Signal sig;
+  signals::connection self;
+  tracked* object = new tracked;
+  sig.connect(0, count_permanent());
+  self = sig.connect(1, reentrant_slot<Signal>(&sig, &self));
+  sig.connect(2, boost::bind(&tracked::call, object, _1));
+  sig.connect(3, destroy_tracked(&object));
+
+  // The lock of the signal is not held while the slots run, so they may
+  // do all of this without deadlocking
+  sig(1);
+  BOOST_CHECK(permanent_calls.get() == 1 + 2);
+  BOOST_CHECK(!self.connected());
+  BOOST_CHECK(object == 0);
+  BOOST_CHECK(sig.num_slots() == 3);
+
+  sig(1);
+  BOOST_CHECK(permanent_calls.get() == 1 + 2 + 1);
+  BOOST_CHECK(sig.num_slots() == 3);
+}
+
+int test_main(int, char* [])
+{
+  test_reentrant_slots<
+    concurrent_signal<signals::snapshot_slot_storage>::type>();
+  test_reentrant_slots<
+    concurrent_signal<signals::flat_slot_storage, signals::spin_lock>::type>();
+  test_reentrant_slots<
+    concurrent_signal<signals::flat_slot_storage, signals::mutex_lock>::type>();
+  test_reentrant_slots<
+    concurrent_signal<signals::flat_slot_storage,
+                      signals::shared_mutex_lock>::type>();
+  test_reentrant_slots<
+    concurrent_signal<signals::node_slot_storage,
+                      signals::spin_lock>::type>();
+
+
+  test_concurrent_calls<
+    concurrent_signal<signals::snapshot_slot_storage>::type>();
+  test_concurrent_calls<
+    concurrent_signal<signals::flat_slot_storage, signals::spin_lock>::type>();
+  test_concurrent_calls<
+    concurrent_signal<signals::flat_slot_storage, signals::mutex_lock>::type>();
+  test_concurrent_calls<
+    concurrent_signal<signals::flat_slot_storage,
+                      signals::shared_mutex_lock>::type>();
+  test_concurrent_calls<
+    concurrent_signal<signals::node_slot_storage,
+                      signals::shared_mutex_lock>::type>();
+
+  test_concurrent_clears<
+    concurrent_signal<signals::snapshot_slot_storage>::type>();
+  test_concurrent_clears<
+    concurrent_signal<signals::flat_slot_storage, signals::spin_lock>::type>();
+  test_concurrent_clears<
+    concurrent_signal<signals::node_slot_storage,
+                      signals::shared_mutex_lock>::type>();
+  return 0;
+}
@@ -55,6 +55,7 @@ test_remove_self()
   test_output = "";
   s0(); std::cout << std::endl;
   BOOST_CHECK(test_output == "013");
+  BOOST_CHECK(s0.num_slots() == 3);
 
   s0.disconnect_all_slots();
   BOOST_CHECK(s0.empty());
@@ -98,6 +99,7 @@ test_remove_self()
   test_output = "";
   s0(); std::cout << std::endl;
   BOOST_CHECK(test_output == "13");
+  BOOST_CHECK(s0.num_slots() == 3);
 
   std::cout << "Unblocking 2" << std::endl;
 
@@ -123,6 +125,7 @@ test_remove_self()
   test_output = "";
   s0(); std::cout << std::endl;
   BOOST_CHECK(test_output == "");
+  BOOST_CHECK(s0.empty());
 }
 
 static void
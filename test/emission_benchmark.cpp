@@ -0,0 +1,159 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+// Measures the cost of calling a signal, in nanoseconds per call, for
+// signals with 0, 1, 8, 64 and 1024 slots. Usage:
+//
+//   emission_benchmark [results.csv]
+
+#include <boost/signal.hpp>
+#include <boost/signals/combiners.hpp>
+#include <boost/signals/inline_function.hpp>
+#include <cstddef>
+#include <vector>
+#include "benchmark.hpp"
+
+using boost::BOOST_SIGNALS_NAMESPACE::connection;
+
+static const int slot_counts[] = { 0, 1, 8, 64, 1024 };
+
+// Keeps the work done by the slots observable
+static long calls;
+
+struct count_call {
+  void operator()() const { ++calls; }
+};
+
+struct add_one {
+  int operator()(int x) const { ++calls; return x + 1; }
+};
+
+struct price {
+  double operator()(double x) const { ++calls; return x * 1.5; }
+};
+
+// How the slots are connected
+enum layout {
+  ungrouped,
+
+  // Spread over eight named groups
+  grouped,
+
+  // A quarter of the slots blocked, and another quarter disconnected
+  blocked_and_disconnected
+};
+
+template<typename Signal, typename Slot>
+void connect_slots(Signal& sig, int slots, layout how)
+{
+  std::vector<connection> connections;
+  for (int i = 0; i < slots; ++i) {
+    if (how == grouped)
+      connections.push_back(sig.connect(i % 8, Slot()));
+    else
+      connections.push_back(sig.connect(Slot()));
+  }
+
+  if (how == blocked_and_disconnected) {
+    for (int i = 0; i < slots; ++i) {
+      if (i % 4 == 1)
+        connections[i].block();
+      else if (i % 4 == 3)
+        connections[i].disconnect();
+    }
+  }
+}
+
+template<typename Signal>
+struct emit_void {
+  emit_void(Signal& s) : sig(s) {}
+  void operator()() { sig(); }
+  Signal& sig;
+};
+
+template<typename Signal>
+struct emit_int {
+  emit_int(Signal& s) : sig(s) {}
+  void operator()() { calls += sig(1); }
+  Signal& sig;
+};
+
+template<typename Signal>
+struct emit_double {
+  emit_double(Signal& s) : sig(s) {}
+  void operator()() { calls += static_cast<long>(sig(1.0)); }
+  Signal& sig;
+};
+
+template<typename Signal, typename Slot, template<typename> class Emit>
+void run(benchmark::report& report, const char* name, layout how,
+         int min_slots = 0)
+{
+  for (std::size_t i = 0; i < sizeof(slot_counts)/sizeof(int); ++i) {
+    int slots = slot_counts[i];
+    if (slots < min_slots)
+      continue;
+
+    Signal sig;
+    connect_slots<Signal, Slot>(sig, slots, how);
+
+    Emit<Signal> emit(sig);
+    long iterations = benchmark::iterations_for(slots);
+    report.add(name, slots, "ns_per_emission",
+               benchmark::ns_per_iteration(emit, iterations));
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace boost::BOOST_SIGNALS_NAMESPACE;
+
+  typedef boost::signal<void ()> void_signal;
+  typedef boost::signal<int (int)> int_signal;
+  typedef boost::signal<int (int), sum<int> > sum_signal;
+  typedef boost::signal<double (double), sum<double> > double_sum_signal;
+  typedef boost::signal<double (double), buffered_sum<double> >
+    buffered_sum_signal;
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, node_slot_storage>
+    node_signal;
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, snapshot_slot_storage>
+    snapshot_signal;
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        inline_function<void ()> >
+    inline_function_signal;
+
+  benchmark::report report("emission", argc, argv);
+
+  run<void_signal, count_call, emit_void>(report, "void_last_value",
+                                          ungrouped);
+  // last_value needs at least one result
+  run<int_signal, add_one, emit_int>(report, "int_last_value", ungrouped, 1);
+  run<sum_signal, add_one, emit_int>(report, "int_sum", ungrouped);
+  run<double_sum_signal, price, emit_double>(report, "double_sum",
+                                             ungrouped);
+  run<buffered_sum_signal, price, emit_double>(report,
+                                               "double_buffered_sum",
+                                               ungrouped);
+  run<void_signal, count_call, emit_void>(report, "void_grouped", grouped);
+  run<void_signal, count_call, emit_void>(report,
+                                          "void_blocked_disconnected",
+                                          blocked_and_disconnected);
+  run<node_signal, count_call, emit_void>(report, "void_node_storage",
+                                          ungrouped);
+  run<snapshot_signal, count_call, emit_void>(report,
+                                              "void_snapshot_storage",
+                                              ungrouped);
+  run<inline_function_signal, count_call, emit_void>(report,
+                                                     "void_inline_function",
+                                                     ungrouped);
+
+  return report.good()? 0 : 1;
+}
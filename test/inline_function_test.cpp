@@ -0,0 +1,153 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/signals/inline_function.hpp>
+#include <boost/bind.hpp>
+#include <functional>
+
+using boost::BOOST_SIGNALS_NAMESPACE::inline_function;
+
+// Whether f keeps its function object, of the type of g, within itself
+template<typename Function, typename F>
+bool held_inline(const Function& f, const F&)
+{
+  const char* target = reinterpret_cast<const char*>(f.template target<F>());
+  const char* begin = reinterpret_cast<const char*>(&f);
+  return target >= begin && target < begin + sizeof(f);
+}
+
+struct add {
+  add(int v) : value(v) {}
+  int operator()(int x) const { return x + value; }
+  int value;
+};
+
+bool operator==(const add& x, const add& y) { return x.value == y.value; }
+
+// Too large for the default buffer
+struct large_add {
+  large_add(int v) : value(v) {}
+  int operator()(int x) const { return x + value; }
+  int value;
+  char padding[64];
+};
+
+struct counter : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
+  counter() : total(0) {}
+  int count(int x) { total += x; return total; }
+  int total;
+};
+
+static int negate(int x) { return -x; }
+
+static void
+test_function()
+{
+  typedef inline_function<int (int)> function_type;
+
+  function_type empty;
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK(!empty);
+  bool threw = false;
+  try {
+    empty(1);
+  } catch (const boost::bad_function_call&) {
+    threw = true;
+  }
+  BOOST_CHECK(threw);
+
+  // Small function objects, function pointers and member functions bound
+  // to an object are kept in place
+  function_type f1(add(2));
+  BOOST_CHECK(f1(1) == 3);
+  BOOST_CHECK(held_inline(f1, add(2)));
+
+  function_type f2(&negate);
+  BOOST_CHECK(f2(1) == -1);
+  BOOST_CHECK(held_inline(f2, &negate));
+
+  counter c;
+  function_type f3(boost::bind(&counter::count, &c, _1));
+  BOOST_CHECK(f3(5) == 5);
+  BOOST_CHECK(held_inline(f3, boost::bind(&counter::count, &c, _1)));
+
+  // Larger ones are allocated
+  function_type f4(large_add(3));
+  BOOST_CHECK(f4(1) == 4);
+  BOOST_CHECK(f4.target<large_add>() != 0);
+  BOOST_CHECK(!held_inline(f4, large_add(3)));
+
+  // Copies are independent of each other
+  function_type f5(f4);
+  f5.target<large_add>()->value = 10;
+  BOOST_CHECK(f4(1) == 4);
+  BOOST_CHECK(f5(1) == 11);
+
+  f5 = f1;
+  BOOST_CHECK(f5(1) == 3);
+  swap(f4, f5);
+  BOOST_CHECK(f4(1) == 3);
+  BOOST_CHECK(f5(1) == 4);
+
+  // Comparison with a function object, as used to disconnect slots
+  BOOST_CHECK(f1 == add(2));
+  BOOST_CHECK(add(3) != f1);
+  BOOST_CHECK(f2 == &negate);
+
+  f1.clear();
+  BOOST_CHECK(f1.empty());
+}
+
+template<typename SlotStorage>
+void test_signal()
+{
+  typedef boost::signal<int (int), boost::last_value<int>, int,
+                        std::less<int>, inline_function<int (int)>,
+                        SlotStorage> signal_type;
+
+  signal_type sig;
+  sig.connect(add(1));
+  sig.connect(add(2));
+  BOOST_CHECK(sig(1) == 3);
+
+  sig.disconnect(add(2));
+  BOOST_CHECK(sig(1) == 2);
+  BOOST_CHECK(sig.num_slots() == 1);
+
+  // Slots bound to a trackable object are disconnected when it is
+  // destroyed
+  {
+    counter c;
+    sig.connect(boost::bind(&counter::count, &c, _1));
+    BOOST_CHECK(sig(4) == 4);
+    BOOST_CHECK(sig(4) == 8);
+  }
+  BOOST_CHECK(sig(1) == 2);
+
+  // Signals may be connected to each other
+  signal_type other;
+  other.connect(add(10));
+  sig.connect(other);
+  BOOST_CHECK(sig(1) == 11);
+}
+
+int test_main(int, char* [])
+{
+  using boost::BOOST_SIGNALS_NAMESPACE::flat_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::node_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::snapshot_slot_storage;
+
+  test_function();
+  test_signal<flat_slot_storage>();
+  test_signal<node_slot_storage>();
+  test_signal<snapshot_slot_storage>();
+  return 0;
+}
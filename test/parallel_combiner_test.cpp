@@ -0,0 +1,197 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/signals/combiners.hpp>
+#include <boost/signals/parallel_combiner.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace signals = boost::BOOST_SIGNALS_NAMESPACE;
+
+// Runs each task on a new thread of the group
+struct thread_executor {
+  explicit thread_executor(boost::thread_group& g) : threads(&g) {}
+
+  template<typename F>
+  void operator()(const F& f) const { threads->create_thread(f); }
+
+  boost::thread_group* threads;
+};
+
+// Runs each task at once, on the calling thread
+struct inline_executor {
+  template<typename F>
+  void operator()(const F& f) const { f(); }
+};
+
+// Counts the calls, and the most slots that were running at once
+struct activity {
+  activity() : calls(0), running(0), most_running(0) {}
+
+  void enter()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    ++calls;
+    if (++running > most_running)
+      most_running = running;
+  }
+
+  void leave()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    --running;
+  }
+
+  boost::mutex mutex;
+  int calls;
+  int running;
+  int most_running;
+};
+
+static activity slots;
+
+// Returns its value after a while
+struct slow_value {
+  slow_value(int v) : value(v) {}
+
+  int operator()(int x) const
+  {
+    slots.enter();
+    boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+    slots.leave();
+    if (value < 0)
+      throw std::runtime_error("negative");
+    return x * value;
+  }
+
+  int value;
+};
+
+struct count_call {
+  void operator()() const { slots.enter(); slots.leave(); }
+};
+
+typedef signals::first_n<int> collect;
+
+template<typename Executor>
+struct parallel_signal {
+  typedef signals::parallel_combiner<collect, Executor> combiner_type;
+  typedef boost::signal<int (int), combiner_type> type;
+};
+
+static void
+test_order()
+{
+  boost::thread_group threads;
+  typedef parallel_signal<thread_executor>::type signal_type;
+  typedef parallel_signal<thread_executor>::combiner_type combiner_type;
+  signal_type sig((combiner_type(thread_executor(threads), collect(100))));
+
+  // Slots are in the order of their groups, whatever the order in which
+  // they return
+  sig.connect(1, slow_value(3));
+  sig.connect(0, slow_value(2));
+  sig.connect(slow_value(4));
+  sig.connect(0, slow_value(1), signals::at_front);
+  signals::connection blocked = sig.connect(1, slow_value(5));
+  blocked.block();
+
+  std::vector<int> results = sig(10);
+  BOOST_CHECK(results.size() == 4);
+  BOOST_CHECK(results[0] == 10 && results[1] == 20);
+  BOOST_CHECK(results[2] == 30 && results[3] == 40);
+  threads.join_all();
+
+  // A single slot is called on the calling thread
+  signal_type single((combiner_type(thread_executor(threads), collect(100))));
+  single.connect(slow_value(7));
+  results = single(1);
+  BOOST_CHECK(results.size() == 1 && results[0] == 7);
+  BOOST_CHECK(single(2)[0] == 14);
+}
+
+static void
+test_concurrency()
+{
+  const int n = 8;
+  boost::thread_group threads;
+  typedef parallel_signal<thread_executor>::type signal_type;
+  typedef parallel_signal<thread_executor>::combiner_type combiner_type;
+  signal_type sig((combiner_type(thread_executor(threads), collect(n))));
+  for (int i = 0; i < n; ++i)
+    sig.connect(slow_value(i));
+
+  slots.calls = slots.most_running = 0;
+  std::vector<int> results = sig(1);
+  threads.join_all();
+  BOOST_CHECK(slots.calls == n);
+  BOOST_CHECK(slots.most_running > 1);
+  for (int i = 0; i < n; ++i)
+    BOOST_CHECK(results[i] == i);
+}
+
+static void
+test_exception()
+{
+  boost::thread_group threads;
+  typedef parallel_signal<thread_executor>::type signal_type;
+  typedef parallel_signal<thread_executor>::combiner_type combiner_type;
+  signal_type sig((combiner_type(thread_executor(threads), collect(10))));
+  sig.connect(slow_value(1));
+  sig.connect(slow_value(-1));
+  sig.connect(slow_value(2));
+
+  // Every slot is called, and the exception reaches the caller
+  slots.calls = 0;
+  bool threw = false;
+  try {
+    sig(1);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  threads.join_all();
+  BOOST_CHECK(threw);
+  BOOST_CHECK(slots.calls == 3);
+}
+
+static void
+test_inline()
+{
+  typedef parallel_signal<inline_executor>::type signal_type;
+  typedef parallel_signal<inline_executor>::combiner_type combiner_type;
+  signal_type sig((combiner_type(inline_executor(), collect(10))));
+  sig.connect(slow_value(1));
+  sig.connect(slow_value(2));
+  std::vector<int> results = sig(3);
+  BOOST_CHECK(results.size() == 2 && results[0] == 3 && results[1] == 6);
+
+  // Slots without results
+  boost::signal<void (),
+                signals::parallel_combiner<boost::last_value<void>,
+                                           inline_executor> > none;
+  none.connect(count_call());
+  none.connect(count_call());
+  none.connect(count_call());
+  slots.calls = 0;
+  none();
+  BOOST_CHECK(slots.calls == 3);
+}
+
+int test_main(int, char* [])
+{
+  test_order();
+  test_concurrency();
+  test_exception();
+  test_inline();
+  return 0;
+}
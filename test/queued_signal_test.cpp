@@ -0,0 +1,277 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signals/queued_signal.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace signals = boost::BOOST_SIGNALS_NAMESPACE;
+
+static std::vector<int> received;
+
+struct record {
+  int operator()(int x) const
+  {
+    if (x < 0)
+      throw std::runtime_error("negative");
+    received.push_back(x);
+    return x;
+  }
+};
+
+// Counts how its copies are made
+struct counted {
+  static int constructed;
+  static int assigned;
+  static bool fail_assignment;
+
+  counted() { ++constructed; }
+  counted(const counted&) { ++constructed; }
+
+  counted& operator=(const counted&)
+  {
+    if (fail_assignment)
+      throw std::runtime_error("assignment");
+    ++assigned;
+    return *this;
+  }
+};
+
+int counted::constructed = 0;
+int counted::assigned = 0;
+bool counted::fail_assignment = false;
+
+struct take_counted {
+  void operator()(const counted&, const std::string& s) const
+  {
+    received.push_back(static_cast<int>(s.size()));
+  }
+};
+
+struct take_string {
+  void operator()(const std::string& s) const
+  {
+    received.push_back(static_cast<int>(s.size()));
+  }
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+  void operator()(std::string&& s) const
+  {
+    std::string taken(std::move(s));
+    received.push_back(static_cast<int>(taken.size()));
+  }
+#endif
+};
+
+static void
+test_post()
+{
+  signals::dispatcher d;
+  signals::queued_signal<int (int)> sig(d);
+  sig.connect(record());
+
+  // Nothing is called until the dispatcher runs
+  received.clear();
+  sig.post(1);
+  sig.post(2);
+  sig.post(3);
+  BOOST_CHECK(received.empty());
+  BOOST_CHECK(d.run() == 3);
+  BOOST_CHECK(received.size() == 3);
+  BOOST_CHECK(received[0] == 1 && received[1] == 2 && received[2] == 3);
+  BOOST_CHECK(d.run() == 0);
+
+  // It is still an ordinary signal
+  BOOST_CHECK(sig(4) == 4);
+  BOOST_CHECK(&sig.get_dispatcher() == &d);
+
+  // Calls of several signals are delivered in the order they were posted
+  signals::queued_signal<void (const std::string&)> other(d);
+  other.connect(take_string());
+  received.clear();
+  sig.post(5);
+  other.post("abc");
+  sig.post(6);
+  BOOST_CHECK(d.run() == 3);
+  BOOST_CHECK(received.size() == 3);
+  BOOST_CHECK(received[0] == 5 && received[1] == 3 && received[2] == 6);
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+  // Arguments passed as rvalues are moved from the stored copies
+  signals::queued_signal<void (std::string&&)> moved(d);
+  moved.connect(take_string());
+  received.clear();
+  moved.post("abcd");
+  d.run();
+  moved.post("ab");
+  d.run();
+  BOOST_CHECK(received.size() == 2);
+  BOOST_CHECK(received[0] == 4 && received[1] == 2);
+#endif
+}
+
+static void
+test_reuse()
+{
+  signals::dispatcher d;
+  signals::queued_signal<void (const counted&, const std::string&)> sig(d);
+  sig.connect(take_counted());
+
+  counted c;
+  counted::constructed = counted::assigned = 0;
+  sig.post(c, "first");
+  sig.post(c, "second");
+  BOOST_CHECK(counted::constructed == 2);
+  d.run();
+
+  // Later calls store their arguments in those of the earlier ones
+  received.clear();
+  sig.post(c, "third");
+  sig.post(c, "fourth");
+  BOOST_CHECK(counted::constructed == 2);
+  BOOST_CHECK(counted::assigned == 2);
+  BOOST_CHECK(d.run() == 2);
+  BOOST_CHECK(received.size() == 2);
+  BOOST_CHECK(received[0] == 5 && received[1] == 6);
+
+  // A call whose arguments cannot be stored is not posted, but it goes
+  // back to the pool
+  counted::fail_assignment = true;
+  bool threw = false;
+  try {
+    sig.post(c, "fifth");
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  counted::fail_assignment = false;
+  BOOST_CHECK(threw);
+  BOOST_CHECK(d.run() == 0);
+
+  sig.post(c, "sixth");
+  sig.post(c, "seventh");
+  BOOST_CHECK(counted::constructed == 2);
+  BOOST_CHECK(d.run() == 2);
+}
+
+static void
+test_exception()
+{
+  signals::dispatcher d;
+  signals::queued_signal<int (int)> sig(d);
+  sig.connect(record());
+
+  received.clear();
+  sig.post(1);
+  sig.post(-1);
+  sig.post(2);
+  bool threw = false;
+  try {
+    d.run();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  BOOST_CHECK(threw);
+  BOOST_CHECK(received.size() == 1);
+
+  // The calls after the one that threw come before those posted since
+  sig.post(3);
+  BOOST_CHECK(d.run() == 2);
+  BOOST_CHECK(received.size() == 3);
+  BOOST_CHECK(received[1] == 2 && received[2] == 3);
+}
+
+static void
+test_destruction()
+{
+  signals::dispatcher d;
+  received.clear();
+  {
+    signals::queued_signal<int (int)> sig(d);
+    sig.connect(record());
+    sig.post(1);
+    sig.post(2);
+  }
+
+  // The calls of a signal that is gone are dropped
+  BOOST_CHECK(d.run() == 0);
+  BOOST_CHECK(received.empty());
+
+  // As are those left in a dispatcher that is destroyed
+  signals::dispatcher* temporary = new signals::dispatcher;
+  signals::queued_signal<int (int)> sig(*temporary);
+  sig.connect(record());
+  sig.post(1);
+  delete temporary;
+  BOOST_CHECK(received.empty());
+}
+
+const int producers = 4;
+const int posts = 20000;
+
+struct from_producer {
+  explicit from_producer(std::vector<std::vector<int> >& r) : results(&r) {}
+
+  void operator()(int producer, int n) const
+  {
+    (*results)[producer].push_back(n);
+  }
+
+  std::vector<std::vector<int> >* results;
+};
+
+template<typename Signal>
+static void produce(Signal* sig, int producer)
+{
+  for (int i = 0; i < posts; ++i)
+    sig->post(producer, i);
+}
+
+static void
+test_producers()
+{
+  std::vector<std::vector<int> > results(producers);
+  signals::dispatcher d;
+  typedef signals::queued_signal<void (int, int)> signal_type;
+  signal_type sig(d);
+  sig.connect(from_producer(results));
+
+  boost::thread_group group;
+  for (int i = 0; i < producers; ++i)
+    group.create_thread(boost::bind(&produce<signal_type>, &sig, i));
+
+  // Deliver the calls while they are being posted
+  std::size_t delivered = 0;
+  while (delivered < std::size_t(producers * posts))
+    delivered += d.run();
+  group.join_all();
+  BOOST_CHECK(d.run() == 0);
+
+  // Every call arrived, in the order in which its thread posted it
+  for (int i = 0; i < producers; ++i) {
+    BOOST_CHECK(results[i].size() == std::size_t(posts));
+    bool ordered = true;
+    for (int j = 0; j < posts; ++j)
+      ordered = ordered && results[i][j] == j;
+    BOOST_CHECK(ordered);
+  }
+}
+
+int test_main(int, char* [])
+{
+  test_post();
+  test_reuse();
+  test_exception();
+  test_destruction();
+  test_producers();
+  return 0;
+}
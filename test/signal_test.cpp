@@ -11,6 +11,8 @@
 #include <boost/signal.hpp>
 #include <functional>
 #include <iostream>
+#include <string>
+#include <utility>
 
 template<typename T>
 struct max_or_default {
@@ -40,6 +42,55 @@ struct make_int {
   int CN;
 };
 
+// Dereferences each iterator twice and compares copies of the iterators,
+// returning the sum of all results. A copy of a dereferenced iterator
+// carries the cached result along.
+template<typename T>
+struct sum_twice {
+  typedef T result_type;
+  template<typename InputIterator>
+  T operator()(InputIterator first, InputIterator last) const
+  {
+    T sum = T();
+    for (; first != last; ++first) {
+      sum += *first;
+      InputIterator copy = first;
+      BOOST_CHECK(copy == first);
+      BOOST_CHECK(*first == *copy);
+    }
+    return sum;
+  }
+};
+
+// Dereferences each iterator twice without using the results
+struct call_twice {
+  typedef void result_type;
+  template<typename InputIterator>
+  void operator()(InputIterator first, InputIterator last) const
+  {
+    for (; first != last; ++first) {
+      *first;
+      *first;
+    }
+  }
+};
+
+struct count_calls {
+  count_calls(int* c) : count(c) {}
+
+  int operator()() const { return ++*count; }
+
+  int* count;
+};
+
+struct count_void_calls {
+  count_void_calls(int* c) : count(c) {}
+
+  void operator()() const { ++*count; }
+
+  int* count;
+};
+
 template<int N>
 struct make_increasing_int {
   make_increasing_int() : n(N) {}
@@ -170,11 +221,180 @@ test_signal_signal_connect()
   BOOST_CHECK(s1(3) == -3);
 }
 
+static void
+test_slot_called_once()
+{
+  int count = 0;
+  boost::signal<int (), sum_twice<int> > s0;
+  BOOST_CHECK(s0() == 0);
+
+  s0.connect(count_calls(&count));
+  boost::BOOST_SIGNALS_NAMESPACE::connection c =
+    s0.connect(count_calls(&count));
+  s0.connect(count_calls(&count));
+  BOOST_CHECK(s0() == 1 + 2 + 3);
+  BOOST_CHECK(count == 3);
+
+  // Disconnected slots are skipped, not called
+  c.disconnect();
+  count = 0;
+  BOOST_CHECK(s0() == 1 + 2);
+  BOOST_CHECK(count == 2);
+
+  int void_count = 0;
+  boost::signal<void (), call_twice> s1;
+  s1.connect(count_void_calls(&void_count));
+  boost::BOOST_SIGNALS_NAMESPACE::connection c1 =
+    s1.connect(count_void_calls(&void_count));
+  s1.connect(count_void_calls(&void_count));
+  s1();
+  BOOST_CHECK(void_count == 3);
+
+  c1.block();
+  void_count = 0;
+  s1();
+  BOOST_CHECK(void_count == 2);
+}
+
+// Counts the copies made of it
+struct copy_counter {
+  explicit copy_counter(int* c) : copies(c) {}
+  copy_counter(const copy_counter& other) : copies(other.copies)
+  { ++*copies; }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+  copy_counter(copy_counter&& other) : copies(other.copies) {}
+#endif
+
+  int* copies;
+};
+
+struct take_counter {
+  typedef void result_type;
+
+  void operator()(const copy_counter&) const {}
+};
+
+static void
+test_argument_copies()
+{
+  int copies = 0;
+  copy_counter counter(&copies);
+
+  // An argument passed by value is copied once by the call; the slot
+  // functions may copy it again for each slot
+  boost::signal<void (copy_counter)> s1;
+  s1.connect(take_counter());
+  s1(counter);
+  int one_slot = copies;
+
+  copies = 0;
+  s1.connect(take_counter());
+  s1(counter);
+  BOOST_CHECK(one_slot - (copies - one_slot) == 1);
+
+  // An argument passed by reference is not copied at all
+  copies = 0;
+  boost::signal<void (const copy_counter&)> s2;
+  s2.connect(take_counter());
+  s2.connect(take_counter());
+  s2(counter);
+  BOOST_CHECK(copies == 0);
+}
+
+struct accumulator : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
+  accumulator() : total(0) {}
+  int add(int x) { total += x; return total; }
+  int get(int) const { return total; }
+  int total;
+};
+
+struct untracked_accumulator {
+  untracked_accumulator() : total(0) {}
+  void add(int x) { total += x; }
+  int total;
+};
+
+static void
+test_connect_member()
+{
+  boost::signal<int (int)> s1;
+  accumulator a;
+  untracked_accumulator u;
+  {
+    accumulator temporary;
+    s1.connect_member(&a, &accumulator::add);
+    s1.connect_member(&temporary, &accumulator::add);
+    BOOST_CHECK(s1(2) == 2);
+    BOOST_CHECK(a.total == 2);
+    BOOST_CHECK(s1.num_slots() == 2);
+  }
+
+  // The slot bound to a trackable object is disconnected with it
+  BOOST_CHECK(s1.num_slots() == 1);
+
+  // Const member functions and groups
+  s1.connect_member(1, &a, &accumulator::get,
+                    boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  BOOST_CHECK(s1(3) == 5);
+  s1.disconnect(1);
+  BOOST_CHECK(s1.num_slots() == 1);
+
+  // Objects that are not trackable, and results that are discarded
+  boost::signal<void (int)> s2;
+  s2.connect_member(&u, &untracked_accumulator::add);
+  s2.connect_member(&a, &accumulator::add);
+  s2(4);
+  BOOST_CHECK(u.total == 4);
+  BOOST_CHECK(a.total == 9);
+}
+
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+struct take_string {
+  take_string(std::string* t) : taken(t) {}
+
+  void operator()(std::string&& s) const { *taken = std::move(s); }
+
+  std::string* taken;
+};
+
+struct sum_eleven {
+  int operator()(int a1, int a2, int a3, int a4, int a5, int a6, int a7,
+                 int a8, int a9, int a10, int a11) const
+  { return a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10 + a11; }
+};
+
+static void
+test_variadic_arguments()
+{
+  // Rvalue reference arguments are passed on as rvalues
+  std::string taken;
+  boost::signal<void (std::string&&), boost::last_value<void>, int,
+                std::less<int>, std::function<void (std::string&&)> > s1;
+  s1.connect(take_string(&taken));
+  s1(std::string("moved"));
+  BOOST_CHECK(taken == "moved");
+
+  // The number of arguments is limited only by the slot function type
+  typedef int signature(int, int, int, int, int, int, int, int, int, int,
+                        int);
+  boost::signal<signature, boost::last_value<int>, int, std::less<int>,
+                std::function<signature> > s11;
+  s11.connect(sum_eleven());
+  BOOST_CHECK(s11(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11) == 66);
+}
+#endif // BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+
 int
 test_main(int, char* [])
 {
   test_zero_args();
   test_one_arg();
   test_signal_signal_connect();
+  test_slot_called_once();
+  test_argument_copies();
+  test_connect_member();
+#ifdef BOOST_SIGNALS_HAS_VARIADIC_TEMPLATES
+  test_variadic_arguments();
+#endif
   return 0;
 }
@@ -0,0 +1,456 @@
+// Boost.Signals library
+
+// Copyright Douglas Gregor 2001-2004. Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#include <boost/test/minimal.hpp>
+#include <boost/signal.hpp>
+#include <boost/bind.hpp>
+#include <string>
+#include <vector>
+
+static std::vector<int> values;
+
+struct record {
+  record(int v) : value(v) {}
+
+  void operator()() const { values.push_back(value); }
+
+  int value;
+};
+
+template<typename Signal>
+struct connect_during_call {
+  connect_during_call(Signal* s) : sig(s) {}
+
+  void operator()() const
+  {
+    values.push_back(-1);
+    sig->connect(record(100));
+    sig->connect(record(200), boost::BOOST_SIGNALS_NAMESPACE::at_front);
+    sig->connect(5, record(300));
+  }
+
+  Signal* sig;
+};
+
+template<typename Signal>
+struct disconnect_group_during_call {
+  disconnect_group_during_call(Signal* s) : sig(s) {}
+
+  void operator()() const
+  {
+    values.push_back(-2);
+    sig->disconnect(1);
+  }
+
+  Signal* sig;
+};
+
+template<typename SlotStorage, typename LockPolicy>
+void test_ordering()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage, LockPolicy>
+    signal_type;
+  signal_type sig;
+
+  sig.connect(record(4));
+  sig.connect(2, record(2));
+  sig.connect(record(0), boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  sig.connect(1, record(1));
+  sig.connect(2, record(3));
+  sig.connect(2, record(-3), boost::BOOST_SIGNALS_NAMESPACE::at_front);
+
+  values.clear();
+  sig();
+  int expected[] = { 0, 1, -3, 2, 3, 4 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 6));
+  BOOST_CHECK(sig.num_slots() == 6);
+
+  sig.disconnect(2);
+  values.clear();
+  sig();
+  int after_group[] = { 0, 1, 4 };
+  BOOST_CHECK(values == std::vector<int>(after_group, after_group + 3));
+  BOOST_CHECK(sig.num_slots() == 3);
+  sig.disconnect_all_slots();
+  values.clear();
+  sig();
+  BOOST_CHECK(values.empty());
+  BOOST_CHECK(sig.empty());
+}
+
+template<typename SlotStorage>
+void test_connect_during_call()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage> signal_type;
+  signal_type sig;
+
+  boost::BOOST_SIGNALS_NAMESPACE::connection c =
+    sig.connect(1, connect_during_call<signal_type>(&sig));
+  sig.connect(record(1));
+
+  // Slots added behind the slot being called are called during this
+  // emission; slots added in front of it are not
+  values.clear();
+  sig();
+  int expected[] = { -1, 300, 1, 100 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 4));
+
+  c.disconnect();
+  values.clear();
+  sig();
+  int after[] = { 200, 300, 1, 100 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 4));
+}
+
+// A slot connected during a call to a signal with snapshot storage is only
+// called from the next call on
+void test_connect_during_snapshot_call()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>,
+                        boost::BOOST_SIGNALS_NAMESPACE::snapshot_slot_storage>
+    signal_type;
+  signal_type sig;
+
+  boost::BOOST_SIGNALS_NAMESPACE::connection c =
+    sig.connect(1, connect_during_call<signal_type>(&sig));
+  sig.connect(record(1));
+
+  values.clear();
+  sig();
+  int expected[] = { -1, 1 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 2));
+
+  c.disconnect();
+  values.clear();
+  sig();
+  int after[] = { 200, 300, 1, 100 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 4));
+}
+
+template<typename SlotStorage>
+void test_disconnect_during_call()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage> signal_type;
+  signal_type sig;
+
+  sig.connect(0, disconnect_group_during_call<signal_type>(&sig));
+  sig.connect(1, record(1));
+  sig.connect(1, record(2));
+  sig.connect(2, record(3));
+
+  values.clear();
+  sig();
+  int expected[] = { -2, 3 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 2));
+  BOOST_CHECK(sig.num_slots() == 2);
+
+  // The group can be reused after it has been removed
+  sig.connect(1, record(4));
+  values.clear();
+  sig();
+  int after[] = { -2, 3 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 2));
+}
+
+template<typename SlotStorage, typename LockPolicy>
+void test_many_disconnects()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage, LockPolicy>
+    signal_type;
+  signal_type sig;
+
+  std::vector<boost::BOOST_SIGNALS_NAMESPACE::connection> connections;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2)
+      connections.push_back(sig.connect(i % 3, record(i)));
+    else
+      connections.push_back(sig.connect(record(i)));
+  }
+
+  // Disconnect most of the slots, in an order that forces the slot
+  // storage to be reorganized several times
+  for (int i = 0; i < 100; ++i) {
+    if (i % 10 != 0)
+      connections[(i * 37) % 100].disconnect();
+  }
+  BOOST_CHECK(sig.num_slots() == 10);
+
+  values.clear();
+  sig();
+  BOOST_CHECK(values.size() == 10);
+
+  // Slots that survived the reorganization can still be disconnected
+  for (int i = 0; i < 100; ++i)
+    connections[i].disconnect();
+  BOOST_CHECK(sig.empty());
+
+  values.clear();
+  sig();
+  BOOST_CHECK(values.empty());
+}
+
+template<typename SlotStorage, typename LockPolicy>
+void test_connect_range()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage, LockPolicy>
+    signal_type;
+  typedef std::vector<boost::BOOST_SIGNALS_NAMESPACE::connection>
+    connections;
+  signal_type sig;
+
+  sig.connect(record(0));
+
+  std::vector<record> back, front, grouped;
+  for (int i = 1; i <= 3; ++i) {
+    back.push_back(record(i));
+    front.push_back(record(-i));
+    grouped.push_back(record(10 * i));
+  }
+
+  connections c = sig.connect_range(back.begin(), back.end());
+  BOOST_CHECK(c.size() == 3);
+  // Each slot of a range connected at the front goes before the previous
+  // one, as if they had been connected one at a time
+  sig.connect_range(front.begin(), front.end(),
+                    boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  sig.connect_range(2, grouped.begin(), grouped.end());
+  sig.connect_range(1, grouped.begin(), grouped.begin() + 1,
+                    boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  BOOST_CHECK(sig.num_slots() == 11);
+
+  // An empty range connects nothing
+  BOOST_CHECK(sig.connect_range(back.end(), back.end()).empty());
+
+  values.clear();
+  sig();
+  int expected[] = { -3, -2, -1, 10, 10, 20, 30, 0, 1, 2, 3 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 11));
+
+  // The connections refer to the slots of the range, in order
+  c[1].disconnect();
+  BOOST_CHECK(c[0].connected() && c[2].connected());
+  sig.disconnect(2);
+  BOOST_CHECK(sig.num_slots() == 7);
+
+  values.clear();
+  sig();
+  int after[] = { -3, -2, -1, 10, 0, 1, 3 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 7));
+}
+
+// Orders strings by length, longest first when reversed
+struct by_length {
+  by_length(bool r = false) : reversed(r) {}
+
+  bool operator()(const std::string& x, const std::string& y) const
+  { return reversed? y.size() < x.size() : x.size() < y.size(); }
+
+  bool reversed;
+};
+
+template<typename SlotStorage>
+void test_group_names()
+{
+  typedef boost::signal<void (), boost::last_value<void>, std::string,
+                        by_length, boost::function<void ()>, SlotStorage>
+    signal_type;
+  signal_type sig(boost::last_value<void>(), by_length(true));
+
+  // The group names are temporaries, so the signal must keep copies
+  sig.connect(std::string("a"), record(3));
+  sig.connect(std::string("bbb"), record(1));
+  sig.connect(std::string("cc"), record(2));
+  sig.connect(std::string("ddd"), record(0),
+              boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  sig.connect(record(4));
+
+  values.clear();
+  sig();
+  int expected[] = { 0, 1, 2, 3, 4 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 5));
+
+  // Groups are found through names that compare equal
+  sig.disconnect(std::string("xyz"));
+  values.clear();
+  sig();
+  int after[] = { 2, 3, 4 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 3));
+  BOOST_CHECK(sig.num_slots() == 3);
+}
+
+// Index groups named by short in [0, 4) only
+namespace boost { namespace BOOST_SIGNALS_NAMESPACE {
+  template<>
+  struct dense_group_limit<short, std::less<short> > {
+    BOOST_STATIC_CONSTANT(int, value = 4);
+  };
+} }
+
+template<typename Group>
+void test_dense_groups()
+{
+  typedef boost::signal<void (), boost::last_value<void>, Group,
+                        std::less<Group> >
+    signal_type;
+  signal_type sig;
+
+  // Names inside and outside of the range of the table
+  sig.connect(16, record(5));
+  sig.connect(3, record(3));
+  sig.connect(-3, record(0));
+  sig.connect(100, record(6));
+  sig.connect(0, record(1));
+  sig.connect(3, record(2), boost::BOOST_SIGNALS_NAMESPACE::at_front);
+  for (int i = 0; i < 10; ++i)
+    sig.connect(5, record(4));
+
+  values.clear();
+  sig();
+  int expected[] = { 0, 1, 2, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 6 };
+  BOOST_CHECK(values == std::vector<int>(expected, expected + 16));
+
+  // Disconnecting most of the slots removes the empty group, and a group
+  // with the same name can be created again
+  sig.disconnect(7);
+  sig.disconnect(5);
+  BOOST_CHECK(sig.num_slots() == 6);
+  sig.connect(5, record(4));
+  sig.disconnect(-3);
+  sig.disconnect(100);
+
+  values.clear();
+  sig();
+  int after[] = { 1, 2, 3, 4, 5 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 5));
+}
+
+struct tracked : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
+  void record(int v) const { values.push_back(v); }
+};
+
+struct destroy_during_call {
+  destroy_during_call(tracked** t) : object(t) {}
+
+  void operator()() const
+  {
+    delete *object;
+    *object = 0;
+  }
+
+  tracked** object;
+};
+
+template<typename SlotStorage, typename LockPolicy>
+void test_trackable_teardown()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage, LockPolicy>
+    signal_type;
+  signal_type sig1, sig2;
+
+  // An object connected many times to one signal and a few times to
+  // another, among slots that are not bound to it
+  tracked* object = new tracked;
+  for (int i = 0; i < 50; ++i) {
+    sig1.connect(i % 5, boost::bind(&tracked::record, object, i));
+    if (i % 10 == 0)
+      sig1.connect(record(-i));
+  }
+  for (int i = 0; i < 3; ++i)
+    sig2.connect(boost::bind(&tracked::record, object, i));
+  sig2.connect(record(100));
+  BOOST_CHECK(sig1.num_slots() == 55);
+  BOOST_CHECK(sig2.num_slots() == 4);
+
+  delete object;
+  BOOST_CHECK(sig1.num_slots() == 5);
+  BOOST_CHECK(sig2.num_slots() == 1);
+
+  values.clear();
+  sig1();
+  sig2();
+  int after[] = { 0, -10, -20, -30, -40, 100 };
+  BOOST_CHECK(values == std::vector<int>(after, after + 6));
+}
+
+template<typename SlotStorage>
+void test_trackable_teardown_during_call()
+{
+  typedef boost::signal<void (), boost::last_value<void>, int, std::less<int>,
+                        boost::function<void ()>, SlotStorage> signal_type;
+  signal_type sig;
+
+  tracked* object = new tracked;
+  for (int i = 0; i < 10; ++i)
+    sig.connect(1, boost::bind(&tracked::record, object, i));
+  sig.connect(0, destroy_during_call(&object));
+  sig.connect(2, record(7));
+
+  values.clear();
+  sig();
+  BOOST_CHECK(object == 0);
+  BOOST_CHECK(values == std::vector<int>(1, 7));
+  BOOST_CHECK(sig.num_slots() == 2);
+
+  values.clear();
+  sig();
+  BOOST_CHECK(values == std::vector<int>(1, 7));
+}
+
+int test_main(int, char* [])
+{
+  using boost::BOOST_SIGNALS_NAMESPACE::flat_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::node_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::snapshot_slot_storage;
+  using boost::BOOST_SIGNALS_NAMESPACE::null_lock;
+  using boost::BOOST_SIGNALS_NAMESPACE::spin_lock;
+
+  test_ordering<flat_slot_storage, null_lock>();
+  test_ordering<node_slot_storage, null_lock>();
+  test_ordering<snapshot_slot_storage, null_lock>();
+  test_ordering<flat_slot_storage, spin_lock>();
+  test_ordering<node_slot_storage, spin_lock>();
+  test_connect_during_call<flat_slot_storage>();
+  test_connect_during_call<node_slot_storage>();
+  test_connect_during_snapshot_call();
+  test_disconnect_during_call<flat_slot_storage>();
+  test_disconnect_during_call<node_slot_storage>();
+  test_disconnect_during_call<snapshot_slot_storage>();
+  test_many_disconnects<flat_slot_storage, null_lock>();
+  test_many_disconnects<node_slot_storage, null_lock>();
+  test_many_disconnects<snapshot_slot_storage, null_lock>();
+  test_many_disconnects<flat_slot_storage, spin_lock>();
+  test_many_disconnects<node_slot_storage, spin_lock>();
+  test_connect_range<flat_slot_storage, null_lock>();
+  test_connect_range<node_slot_storage, null_lock>();
+  test_connect_range<snapshot_slot_storage, null_lock>();
+  test_connect_range<flat_slot_storage, spin_lock>();
+  test_connect_range<node_slot_storage, spin_lock>();
+  test_group_names<flat_slot_storage>();
+  test_group_names<node_slot_storage>();
+  test_group_names<snapshot_slot_storage>();
+  test_dense_groups<int>();
+  test_dense_groups<short>();
+  test_dense_groups<long>();
+  test_trackable_teardown<flat_slot_storage, null_lock>();
+  test_trackable_teardown<node_slot_storage, null_lock>();
+  test_trackable_teardown<snapshot_slot_storage, null_lock>();
+  test_trackable_teardown<flat_slot_storage, spin_lock>();
+  test_trackable_teardown<node_slot_storage, spin_lock>();
+  test_trackable_teardown_during_call<flat_slot_storage>();
+  test_trackable_teardown_during_call<node_slot_storage>();
+  test_trackable_teardown_during_call<snapshot_slot_storage>();
+  return 0;
+}
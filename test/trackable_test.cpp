@@ -17,6 +17,9 @@ struct short_lived : public boost::BOOST_SIGNALS_NAMESPACE::trackable {
 
 struct swallow {
   template<typename T> int operator()(const T*, int i) { return i; }
+
+  template<typename T>
+  int operator()(const T*, const T*, const T*, int i) { return i; }
 };
 
 template<typename T>
@@ -61,5 +64,57 @@ int test_main(int, char*[])
     BOOST_CHECK(s1(5) == 0);
   }
 
+  // Test auto-disconnection of a slot bound to several objects, by any
+  // one of them
+  {
+    short_lived first, second;
+    {
+      short_lived third;
+      s1.connect(boost::bind<int>(swallow(), &first, &second, &third, _1));
+      BOOST_CHECK(s1(5) == 5);
+    }
+    BOOST_CHECK(s1(5) == 0);
+
+    boost::BOOST_SIGNALS_NAMESPACE::connection c =
+      s1.connect(boost::bind<int>(swallow(), &first, &second, &first, _1));
+    BOOST_CHECK(s1(5) == 5);
+    c.disconnect();
+    BOOST_CHECK(s1(5) == 0);
+  }
+
+  // Test an object connected to many signals, some of which are
+  // disconnected before it is destroyed
+  {
+    sig_type many[8];
+    boost::BOOST_SIGNALS_NAMESPACE::connection c[8];
+    {
+      short_lived shorty;
+      for (int i = 0; i < 8; ++i)
+        c[i] = many[i].connect(boost::bind<int>(swallow(), &shorty, _1));
+
+      c[0].disconnect();
+      c[3].disconnect();
+      c[7].disconnect();
+      for (int i = 0; i < 8; ++i)
+        BOOST_CHECK(many[i](i) == (c[i].connected()? i : 0));
+    }
+    for (int i = 0; i < 8; ++i) {
+      BOOST_CHECK(!c[i].connected());
+      BOOST_CHECK(many[i](i) == 0);
+    }
+  }
+
+  // Test that assigning to a trackable object disconnects its slots
+  {
+    short_lived shorty, other;
+    s1.connect(boost::bind<int>(swallow(), &shorty, _1));
+    BOOST_CHECK(s1(5) == 5);
+    shorty = other;
+    BOOST_CHECK(s1(5) == 0);
+    s1.connect(boost::bind<int>(swallow(), &shorty, _1));
+    BOOST_CHECK(s1(5) == 5);
+  }
+  BOOST_CHECK(s1(5) == 0);
+
   return 0;
 }